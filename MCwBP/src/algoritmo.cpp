@@ -1,24 +1,53 @@
 #include "algoritmo.h"
+#include "migracion.h"
+#include "checkpoint.h"
+#include "progreso.h"
+#include "cota.h"
 #include <iostream>
 #include <vector>
 #include <algorithm> // Para shuffle
-#include <random> // Para default_random_engine
+#include <random> // Para mt19937
 #include <limits> // Para DBL_MAX
 #include <cmath> // Para exp()
+#include <chrono> // Para medir el tiempo al primer factible
+#include <set> // Para comparar aristas entre soluciones
+#include <memory> // Para unique_ptr
+#include <filesystem> // Para detectar checkpoints existentes
 
 using namespace std;
 
-Algoritmo::Algoritmo(const Instancia& inst, long s) : inst(inst), seed(s) {
-    srand(seed); // inicializar generador de números aleatorios
+Algoritmo::Algoritmo(const Instancia& inst, long s)
+    : inst(inst), seed(s), rng(s),  // inicializar generador de números aleatorios
+      indiceEspacial(inst),
+      pesoCapacidad(parametrosPenalizacion.pesoCapacidadInicial),
+      pesoCuota(parametrosPenalizacion.pesoCuotaInicial),
+      poolSoluciones(inst.numCamiones, inst.granjas.size()) {
+}
+
+// entero uniforme en [0, n). se usa un generador propio (y no rand()) para poder
+// guardar y restaurar su estado en los checkpoints
+int Algoritmo::aleatorio(int n) {
+    return rng() % n;
 }
 
 Solucion Algoritmo::generarSolucionInicialGreedy() {
     vector<vector<int>> rutas(inst.numCamiones);
-    vector<int> cargasActuales(inst.numCamiones, 0);
     
     // copiar granjas para manipular
     vector<Nodo> granjasCandidatas = inst.granjas;
     vector<int> granjasNoVisitadasIDs;
+
+    insertarGranjasGreedy(rutas, granjasCandidatas, granjasNoVisitadasIDs);
+
+    return Solucion(rutas, granjasNoVisitadasIDs, inst);
+}
+
+void Algoritmo::insertarGranjasGreedy(vector<vector<int>>& rutas, vector<Nodo> granjasCandidatas, vector<int>& granjasNoVisitadasIDs) const {
+    // cargas de las rutas ya existentes
+    vector<int> cargasActuales(inst.numCamiones, 0);
+    for (int k = 0; k < inst.numCamiones; ++k) {
+        for (int granjaId : rutas[k]) cargasActuales[k] += inst.getNodo(granjaId).cantidadLeche;
+    }
     
     // ordenar granjas por prioridad 
     sort(granjasCandidatas.begin(), granjasCandidatas.end(), [](const Nodo& a, const Nodo& b) {
@@ -49,9 +78,9 @@ Solucion Algoritmo::generarSolucionInicialGreedy() {
             }
 
             // probar todas las posiciones posibles en la ruta k
-            for (int pos = 0; pos <= rutas[k].size(); ++pos) {
+            for (int pos = 0; pos <= (int)rutas[k].size(); ++pos) {
                 int nodoPrev = (pos == 0) ? inst.planta.id : rutas[k][pos - 1];
-                int nodoSig = (pos == rutas[k].size()) ? inst.planta.id : rutas[k][pos];
+                int nodoSig = (pos == (int)rutas[k].size()) ? inst.planta.id : rutas[k][pos];
 
                 double costoInsercion = inst.getDistancia(nodoPrev, granja.id) +
                                       inst.getDistancia(granja.id, nodoSig) -
@@ -76,85 +105,428 @@ Solucion Algoritmo::generarSolucionInicialGreedy() {
             granjasNoVisitadasIDs.push_back(granja.id);
         }        
     }
+}
 
-    return Solucion(rutas, granjasNoVisitadasIDs, inst);
+
+const char* nombreEvento(EventoSA evento) {
+    switch (evento) {
+        case EventoSA::Recalentamiento: return "recalentamiento";
+        case EventoSA::Reinicio: return "reinicio";
+        default: return "";
+    }
 }
 
+// calibración de temperaturas a partir de deltas de energía muestreados alrededor de 'base'
+CalibracionTemperatura Algoritmo::calibrarTemperaturas(const Solucion& base, int muestras,
+                                                       double probInicial, double probFinal,
+                                                       double percentilAlto, double percentilBajo) {
+    pesoCapacidad = parametrosPenalizacion.pesoCapacidadInicial;
+    pesoCuota = parametrosPenalizacion.pesoCuotaInicial;
+    double energiaBase = calcularEnergia(base);
+
+    vector<double> deltas;
+    for (int i = 0; i < muestras; ++i) {
+        double delta = energiaBase - calcularEnergia(generarVecino(base));
+        if (delta > 0.0) deltas.push_back(delta);
+    }
+
+    CalibracionTemperatura cal;
+    cal.muestras = muestras;
+    cal.empeoramientos = deltas.size();
+
+    // sin empeoramientos no hay información: se usa una escala relativa al profit
+    if (deltas.empty()) {
+        cal.deltaAlto = cal.deltaBajo = max(1.0, fabs(base.profit) * 0.01);
+    } else {
+        // la distribución tiene cola pesada (saltos de penalización de cuotas), por eso se
+        // usan percentiles en vez de la media
+        sort(deltas.begin(), deltas.end());
+        cal.deltaAlto = deltas[(size_t)(percentilAlto * (deltas.size() - 1))];
+        cal.deltaBajo = deltas[(size_t)(percentilBajo * (deltas.size() - 1))];
+    }
+
+    // exp(-delta / T) = p  =>  T = -delta / ln(p)
+    cal.tempInicial = -cal.deltaAlto / log(probInicial);
+    cal.tempFinal = -cal.deltaBajo / log(probFinal);
+    if (cal.tempFinal >= cal.tempInicial) cal.tempFinal = cal.tempInicial * 0.001;
+
+    return cal;
+}
 
 // Simulated Annealing 
 
 Solucion Algoritmo::ejecutarSimulatedAnnealing(double tempInicial, double tempFinal, double tasaEnfriamiento) {
+    return ejecutarSimulatedAnnealing(generarSolucionInicialGreedy(), tempInicial, tempFinal, tasaEnfriamiento);
+}
+
+Solucion Algoritmo::ejecutarSimulatedAnnealing(const Solucion& solInicial, double tempInicial, double tempFinal, double tasaEnfriamiento) {
     
-    cout << "Iniciando Simulated Annealing..." << endl;
+    if (mostrarLog) cout << "Iniciando Simulated Annealing..." << endl;
 
     historialConvergencia.clear();
-    
-    Solucion solActual = generarSolucionInicialGreedy();
-    Solucion mejorSolucion = solActual;
+    cursorHistorial = 0;
+    if (!parametrosCheckpoint.ruta.empty()) EscritorCheckpoint::borrar(parametrosCheckpoint.ruta); // restos de otra ejecución
+    tiempoPrimerFactible = -1.0;
+    iteracionPrimerFactible = -1;
+
+    // los pesos parten de sus valores iniciales en cada ejecución
+    pesoCapacidad = parametrosPenalizacion.pesoCapacidadInicial;
+    pesoCuota = parametrosPenalizacion.pesoCuotaInicial;
+
+    EstadoSA& e = estado;
+    e = EstadoSA();
+    e.solActual = solInicial;
+    indiceRutasValido = false;
+    e.mejorSolucion = e.solActual;
+
+    e.tempInicial = tempInicial;
+    e.tempFinal = tempFinal;
+    e.temperatura = tempInicial;
+    e.tasaEnfriamiento = tasaEnfriamiento;
+    e.energiaActual = calcularEnergia(e.solActual, e.infActual);
+    e.mejorEnergia = e.energiaActual;
+
+    if (e.solActual.esFactible) {
+        tiempoPrimerFactible = 0.0;
+        iteracionPrimerFactible = 0;
+    }
 
-    double temperatura = tempInicial;
-    double energiaActual = calcularEnergia(solActual);
-    double mejorEnergia = energiaActual;
+    estadisticasReparacion = EstadisticasReparacion();
 
-    int iteracion = 0;
+    // control de estancamiento
+    numRecalentamientos = 0;
+    numReinicios = 0;
+    migrantesRecibidos = 0;
+    migrantesAdoptados = 0;
+    elite.clear();
+    actualizarElite(e.solActual, e.infActual);
+
+    // presupuesto fijo de iteraciones: las que tomaría enfriar de tempInicial a tempFinal.
+    // recalentar no alarga la ejecución, solo redistribuye las iteraciones.
+    if (tempInicial > tempFinal && tasaEnfriamiento < 1.0) {
+        e.maxIteraciones = (long long)ceil(log(tempFinal / tempInicial) / log(tasaEnfriamiento));
+    }
+
+    return continuarSimulatedAnnealing();
+}
+
+// bucle principal de SA. todo lo que necesita está en 'estado' y en los miembros que guarda un
+// checkpoint, por lo que se puede retomar desde un checkpoint de forma idéntica.
+Solucion Algoritmo::continuarSimulatedAnnealing() {
+    EstadoSA& e = estado;
+    Solucion& solActual = e.solActual;
+
+    // la mejor solución se guarda compacta: reemplazarla no reserva memoria
+    SolucionCompacta mejorSolucion(poolSoluciones, e.mejorSolucion);
+    Infactibilidad infMejor = medirInfactibilidad(e.mejorSolucion);
+    double& energiaActual = e.energiaActual;
+    double& mejorEnergia = e.mejorEnergia;
+    double& temperatura = e.temperatura;
+    long long& iteracion = e.iteracion;
+
+    // el reloj continúa desde lo ya transcurrido (si se retoma de un checkpoint)
+    auto inicio = chrono::steady_clock::now() - chrono::duration_cast<chrono::steady_clock::duration>(
+                      chrono::duration<double>(e.segundosTranscurridos));
+
+    unique_ptr<EscritorCheckpoint> escritor;
+    if (!parametrosCheckpoint.ruta.empty() && parametrosCheckpoint.intervalo > 0) {
+        escritor = make_unique<EscritorCheckpoint>(parametrosCheckpoint.ruta);
+    }
+
+    auto publicarProgreso = [&](bool terminada) {
+        progreso->publicar({iteracion, e.maxIteraciones, mejorSolucion.profit, mejorSolucion.esFactible,
+                            temperatura, terminada});
+    };
+    cancelada = false;
+    terminadaPorBrecha = false;
+
+    while (iteracion < e.maxIteraciones && !terminadaPorBrecha) {
+        if (cancelacion && cancelacion->cancelado()) {
+            cancelada = true;
+            break;
+        }
+        if (progreso && intervaloProgreso > 0 && iteracion % intervaloProgreso == 0) publicarProgreso(false);
 
-    while (temperatura > tempFinal) {
         // 1. generar un vecino
         Solucion solVecina = generarVecino(solActual);
-        double energiaVecina = calcularEnergia(solVecina);
+        Infactibilidad infVecina;
+        double energiaVecina = calcularEnergia(solVecina, infVecina);
+
+        if (energiaVecina < energiaActual) {
+            e.deltaPromedio += 0.001 * ((energiaActual - energiaVecina) - e.deltaPromedio);
+        }
 
         // 2. decidir si aceptar el vecino
         if (aceptarSolucion(energiaVecina, energiaActual, temperatura)) {
             solActual = solVecina;
+            if (indiceRutasValido) {
+                for (int k : rutasModificadas) indexarRuta(solActual.rutas, k);
+            }
             energiaActual = energiaVecina;
+            e.infActual = infVecina;
         }
 
         // 3. actualizar la mejor solución encontrada
-        if (energiaActual > mejorEnergia) {
-            mejorSolucion = solActual;
+        if (esMejor(solActual.esFactible, energiaActual, mejorSolucion.esFactible, mejorEnergia)) {
+            mejorSolucion.guardar(solActual);
+            infMejor = e.infActual;
             mejorEnergia = energiaActual;
+            e.iteracionUltimaMejora = iteracion;
+            e.mejoroDesdeUltimoEvento = true;
+            actualizarElite(solActual, e.infActual);
+
+            // la cota prueba que no queda (casi) nada por ganar: se termina tras esta iteración
+            if (cotaSuperior && mejorSolucion.esFactible &&
+                brechaOptimalidad(mejorSolucion.profit, *cotaSuperior) <= epsilonBrecha) {
+                terminadaPorBrecha = true;
+            }
+        }
+
+        // modelo de islas: intercambio periódico de élites con las demás islas
+        if (canalMigracion && intervaloMigracion > 0 && iteracion > 0 && iteracion % intervaloMigracion == 0) {
+            Solucion mejorExpandida = mejorSolucion.expandir();
+            if (migrar(solActual, mejorExpandida)) {
+                indiceRutasValido = false;
+                mejorSolucion.guardar(mejorExpandida);
+                energiaActual = calcularEnergia(solActual, e.infActual);
+                mejorEnergia = calcularEnergia(mejorExpandida, infMejor);
+                e.iteracionUltimaMejora = iteracion;
+                e.mejoroDesdeUltimoEvento = true;
+            }
         }
 
-        if (iteracion % 100 == 0) {
-            // guardamos la iteración actual y el profit de la solución encontrada hasta el momento
-            historialConvergencia.push_back({iteracion, mejorSolucion.profit});
+        if (iteracionPrimerFactible < 0 && solActual.esFactible) {
+            tiempoPrimerFactible = chrono::duration<double>(chrono::steady_clock::now() - inicio).count();
+            iteracionPrimerFactible = iteracion;
+        }
+
+        // 4. penalización adaptativa: los pesos suben si la cadena ha estado infactible
+        // y bajan si ha estado factible. al cambiar, se re-evalúan la actual y la mejor
+        // para que las comparaciones siguientes usen la misma escala.
+        if (parametrosPenalizacion.adaptativa) {
+            if (e.infActual.excesoCapacidad == 0) e.factiblesCapacidad++;
+            if (e.infActual.deficitCuota == 0) e.factiblesCuota++;
+            e.iteracionesVentana++;
+
+            if (e.iteracionesVentana >= parametrosPenalizacion.ventana) {
+                if (ajustarPesos(e.factiblesCapacidad, e.factiblesCuota, e.iteracionesVentana)) {
+                    energiaActual = calcularEnergia(solActual);
+                    mejorEnergia = energia(mejorSolucion.profit, infMejor);
+                }
+                e.factiblesCapacidad = 0;
+                e.factiblesCuota = 0;
+                e.iteracionesVentana = 0;
+            }
+        }
+
+        // 5. estancamiento: sin mejoras durante una ventana proporcional a lo avanzado.
+        // primero se recalienta; si vuelve a estancarse sin mejorar, se reinicia desde el élite.
+        EventoSA evento = EventoSA::Ninguno;
+        const ParametrosEstancamiento& pe = parametrosEstancamiento;
+        long long ventanaEstancamiento = max((long long)pe.ventanaMinima, (long long)(pe.fraccionVentana * iteracion));
+        if (pe.activo && iteracion - e.iteracionUltimaMejora > ventanaEstancamiento) {
+            // temperatura a la que un empeoramiento típico se acepta con prob. probRecalentamiento
+            double tempRecalentada = (e.deltaPromedio > 0.0) ? -e.deltaPromedio / log(pe.probRecalentamiento) : e.tempInicial;
+            tempRecalentada = min(tempRecalentada, e.tempInicial);
+
+            if (!e.mejoroDesdeUltimoEvento && elite.size() > 1) {
+                // reiniciar desde un élite distinto del mejor para diversificar
+                solActual = elite[1 + aleatorio(elite.size() - 1)].sol.expandir();
+                indiceRutasValido = false;
+                energiaActual = calcularEnergia(solActual, e.infActual);
+                evento = EventoSA::Reinicio;
+                numReinicios++;
+            } else if (tempRecalentada > temperatura) {
+                evento = EventoSA::Recalentamiento;
+                numRecalentamientos++;
+            }
+            // si la cadena sigue más caliente que la temperatura de recalentamiento no hay evento:
+            // solo se reinicia la ventana de estancamiento
+            if (evento != EventoSA::Ninguno) {
+                temperatura = max(temperatura, tempRecalentada);
+
+                // re-ajustar el enfriamiento para llegar a tempFinal justo al agotar el presupuesto
+                long long restantes = e.maxIteraciones - iteracion;
+                if (restantes > 0 && temperatura > e.tempFinal) {
+                    e.tasaEnfriamiento = pow(e.tempFinal / temperatura, 1.0 / restantes);
+                }
+                e.mejoroDesdeUltimoEvento = false;
+            }
+            e.iteracionUltimaMejora = iteracion;
+        }
+
+        if (iteracion % 100 == 0 || evento != EventoSA::Ninguno) {
+            // guardamos la iteración actual, el profit de la mejor solución, los pesos vigentes y el evento
+            historialConvergencia.push_back({iteracion, mejorSolucion.profit, pesoCapacidad, pesoCuota, evento});
         }      
 
-        // 4. enfriar (se enfriará cada iteración)
-        temperatura *= tasaEnfriamiento;
-        iteracion++;                                                                                                                                                                                                                                                                                                                                                                                    
+        // 6. enfriar (se enfriará cada iteración)
+        temperatura *= e.tasaEnfriamiento;
+        iteracion++;
+
+        // 7. checkpoint periódico: se copia el estado y el hilo escritor lo persiste
+        if (escritor && iteracion % parametrosCheckpoint.intervalo == 0) {
+            e.segundosTranscurridos = chrono::duration<double>(chrono::steady_clock::now() - inicio).count();
+            e.mejorSolucion = mejorSolucion.expandir();
+            escritor->encolar(capturarCheckpoint());
+        }
+
+        // 8. límite de tiempo: se estima cuántas iteraciones caben en el tiempo restante y, si son
+        // menos que las del presupuesto, se acorta el presupuesto y se re-ajusta el enfriamiento
+        if (limiteSegundos > 0.0 && iteracion % 1024 == 0) {
+            double transcurrido = chrono::duration<double>(chrono::steady_clock::now() - inicio).count();
+            if (transcurrido >= limiteSegundos) break;
+
+            long long caben = (long long)(iteracion / transcurrido * (limiteSegundos - transcurrido));
+            if (iteracion + caben < e.maxIteraciones) {
+                e.maxIteraciones = iteracion + max(1LL, caben);
+                if (temperatura > e.tempFinal) {
+                    e.tasaEnfriamiento = pow(e.tempFinal / temperatura, 1.0 / (e.maxIteraciones - iteracion));
+                }
+            }
+        }
+    }
+
+    if (escritor) {
+        // la ejecución terminó: los checkpoints ya no sirven
+        escritor.reset();
+        if (parametrosCheckpoint.borrarAlTerminar) EscritorCheckpoint::borrar(parametrosCheckpoint.ruta);
+    }
+
+    iteracionesRealizadas = iteracion;
+    if (progreso) publicarProgreso(true);
+    if (mostrarLog) cout << "Simulated Annealing terminado." << endl;
+    e.mejorSolucion = mejorSolucion.expandir();
+    return e.mejorSolucion;
+}
+
+Solucion Algoritmo::ejecutarSimulatedAnnealing(const ParametrosSA& params) {
+    // si hay un checkpoint de una ejecución interrumpida, se continúa desde él
+    if (!parametrosCheckpoint.ruta.empty() && std::filesystem::exists(parametrosCheckpoint.ruta)) {
+        return reanudarSimulatedAnnealing(parametrosCheckpoint.ruta);
+    }
+
+    double tIni = params.tempInicial, tFin = params.tempFinal, tasa = params.tasaEnfriamiento;
+
+    temperaturaCalibrada = params.calibrarTemperatura;
+    if (params.calibrarTemperatura) {
+        calibracion = calibrarTemperaturas(generarSolucionInicialGreedy(), params.muestrasCalibracion,
+                                           params.probAceptacionInicial, params.probAceptacionFinal);
+        // conservar el número de iteraciones del esquema configurado
+        double iteraciones = log(params.tempFinal / params.tempInicial) / log(params.tasaEnfriamiento);
+        tIni = calibracion.tempInicial;
+        tFin = calibracion.tempFinal;
+        tasa = pow(tFin / tIni, 1.0 / iteraciones);
+        tasaCalibrada = tasa;
+    }
+
+    return ejecutarSimulatedAnnealing(tIni, tFin, tasa);
+}
+
+Solucion Algoritmo::reanudarSimulatedAnnealing(const string& pathCheckpoint) {
+    if (mostrarLog) cout << "Reanudando Simulated Annealing desde " << pathCheckpoint << "..." << endl;
+
+    Checkpoint ckpt;
+    if (!EscritorCheckpoint::cargar(pathCheckpoint, inst, ckpt)) {
+        throw runtime_error("Checkpoint inválido o de otra instancia: " + pathCheckpoint);
     }
+    restaurarCheckpoint(ckpt);
+
+    // el historial persistido llega hasta el cursor guardado en el checkpoint
+    historialConvergencia = EscritorCheckpoint::cargarHistorial(pathCheckpoint, ckpt.cursorHistorial);
+
+    return continuarSimulatedAnnealing();
+}
 
-    cout << "Simulated Annealing terminado." << endl;
-    return mejorSolucion;
+Checkpoint Algoritmo::capturarCheckpoint() {
+    Checkpoint ckpt;
+    ckpt.seed = seed;
+    ckpt.estado = estado;
+    ckpt.rng = rng;
+    ckpt.pesoCapacidad = pesoCapacidad;
+    ckpt.pesoCuota = pesoCuota;
+    for (const MiembroElite& m : elite) ckpt.elite.push_back(m.sol.expandir());
+    ckpt.numRecalentamientos = numRecalentamientos;
+    ckpt.numReinicios = numReinicios;
+    ckpt.tiempoPrimerFactible = tiempoPrimerFactible;
+    ckpt.iteracionPrimerFactible = iteracionPrimerFactible;
+    ckpt.temperaturaCalibrada = temperaturaCalibrada;
+    ckpt.calibracion = calibracion;
+    ckpt.tasaCalibrada = tasaCalibrada;
+    ckpt.estadisticasReparacion = estadisticasReparacion;
+    ckpt.migrantesRecibidos = migrantesRecibidos;
+    ckpt.migrantesAdoptados = migrantesAdoptados;
+
+    // solo viajan al escritor los registros nuevos desde el checkpoint anterior
+    ckpt.historialNuevo.assign(historialConvergencia.begin() + cursorHistorial, historialConvergencia.end());
+    cursorHistorial = historialConvergencia.size();
+    ckpt.cursorHistorial = cursorHistorial;
+    return ckpt;
+}
+
+void Algoritmo::restaurarCheckpoint(const Checkpoint& ckpt) {
+    seed = ckpt.seed;
+    estado = ckpt.estado;
+    indiceRutasValido = false;
+    rng = ckpt.rng;
+    pesoCapacidad = ckpt.pesoCapacidad;
+    pesoCuota = ckpt.pesoCuota;
+    elite.clear();
+    for (const Solucion& sol : ckpt.elite) elite.push_back({SolucionCompacta(poolSoluciones, sol), medirInfactibilidad(sol)});
+    numRecalentamientos = ckpt.numRecalentamientos;
+    numReinicios = ckpt.numReinicios;
+    tiempoPrimerFactible = ckpt.tiempoPrimerFactible;
+    iteracionPrimerFactible = ckpt.iteracionPrimerFactible;
+    temperaturaCalibrada = ckpt.temperaturaCalibrada;
+    calibracion = ckpt.calibracion;
+    tasaCalibrada = ckpt.tasaCalibrada;
+    estadisticasReparacion = ckpt.estadisticasReparacion;
+    migrantesRecibidos = ckpt.migrantesRecibidos;
+    migrantesAdoptados = ckpt.migrantesAdoptados;
+    cursorHistorial = ckpt.cursorHistorial;
 }
 
 // devuelve una nueva solución aplicando un movimiento aleatorio
 Solucion Algoritmo::generarVecino(const Solucion& solActual) {
     vector<vector<int>> nuevasRutas = solActual.rutas;
     vector<int> nuevasNoVisitadas = solActual.granjasNoVisitadas;
+    rutasModificadas.clear();
 
     // si no hay rutas y tampoco no visitados, no se puede hacer nada
     if (nuevasRutas.empty() && nuevasNoVisitadas.empty()) return solActual;
 
+    // reparación: una granja no visitada va a su mejor posición factible en vez de a una al azar
+    if (!nuevasNoVisitadas.empty() && frecuenciaReparacion > 0 && aleatorio(frecuenciaReparacion) == 0) {
+        // fuera del bucle de SA (calibración) el índice se arma para la solución recibida
+        if (&solActual != &estado.solActual || !indiceRutasValido) {
+            indexarRutas(solActual.rutas);
+            indiceRutasValido = (&solActual == &estado.solActual);
+        }
+        int pos = aleatorio(nuevasNoVisitadas.size());
+        if (!repararGranja(nuevasRutas, nuevasNoVisitadas[pos])) return solActual;
+        nuevasNoVisitadas.erase(nuevasNoVisitadas.begin() + pos);
+        return Solucion(nuevasRutas, nuevasNoVisitadas, inst);
+    }
+
     // elegir entre 2opt o shift generalizado
-    int tipoMovimiento = rand() % 2;
+    int tipoMovimiento = aleatorio(2);
 
     // 2opt intra-ruta
     // mejora la calidad de una ruta individual invirtiendo un segmento.
     if (tipoMovimiento == 0) {
         // elegir una ruta aleatoria que tenga al menos 2 nodos
-        int k = rand() % nuevasRutas.size();
+        int k = aleatorio(nuevasRutas.size());
         size_t intentos = 0;
         while (nuevasRutas[k].size() < 2 && intentos < 10) {
-            k = rand() % nuevasRutas.size();                                                                                                                                                                                                                                                                                                                                                          
+            k = aleatorio(nuevasRutas.size());                                                                                                                                                                                                                                                                                                                                                          
             intentos++;
         }
         
         if (nuevasRutas[k].size() >= 2) {
-            int i = rand() % (nuevasRutas[k].size() - 1);
-            int j = (rand() % (nuevasRutas[k].size() - 1 - i)) + i + 1;
+            int i = aleatorio(nuevasRutas[k].size() - 1);
+            int j = aleatorio(nuevasRutas[k].size() - 1 - i) + i + 1;
             std::reverse(nuevasRutas[k].begin() + i, nuevasRutas[k].begin() + j + 1);
+            rutasModificadas.push_back(k);
         }
     } 
     // shift generalizado 
@@ -165,15 +537,15 @@ Solucion Algoritmo::generarVecino(const Solucion& solActual) {
         int origenIdx = -1;
         
         // probabilidad de sacar de "No Visitados" vs "Rutas"
-        bool sacarDeNoVisitados = (!nuevasNoVisitadas.empty()) && (rand() % 2 == 0);
+        bool sacarDeNoVisitados = (!nuevasNoVisitadas.empty()) && (aleatorio(2) == 0);
         
         if (!sacarDeNoVisitados) {
             // sacar de una ruta existente
-            origenIdx = rand() % nuevasRutas.size();
+            origenIdx = aleatorio(nuevasRutas.size());
             // buscar una ruta que no esté vacía
             size_t intentos = 0;
             while (nuevasRutas[origenIdx].empty() && intentos < 10) {
-                origenIdx = rand() % nuevasRutas.size();
+                origenIdx = aleatorio(nuevasRutas.size());
                 intentos++;
             }
             if (nuevasRutas[origenIdx].empty()) return solActual; // no hay nada que mover
@@ -184,12 +556,12 @@ Solucion Algoritmo::generarVecino(const Solucion& solActual) {
         
         // no permitimos mover de "No Visitados" a "No Visitados"
         if (origenIdx == -1) {
-            destinoIdx = rand() % nuevasRutas.size(); // debe ir a una ruta
+            destinoIdx = aleatorio(nuevasRutas.size()); // debe ir a una ruta
         } else {
             // puede ir a otra ruta o a "No Visitados"
             // damos alta probabilidad a ir a otra ruta para fomentar el intercambio
-            if (rand() % 10 < 8) { 
-                destinoIdx = rand() % nuevasRutas.size();
+            if (aleatorio(10) < 8) { 
+                destinoIdx = aleatorio(nuevasRutas.size());
             } else {
                 destinoIdx = -1; // drop
             }
@@ -199,15 +571,17 @@ Solucion Algoritmo::generarVecino(const Solucion& solActual) {
         if (origenIdx == destinoIdx) return solActual;
 
         // 3. ejecutar el movimiento
+        if (origenIdx != -1) rutasModificadas.push_back(origenIdx);
+        if (destinoIdx != -1) rutasModificadas.push_back(destinoIdx);
         int granjaId;
         
         // A. extraer del origen
         if (origenIdx == -1) {
-            int pos = rand() % nuevasNoVisitadas.size();
+            int pos = aleatorio(nuevasNoVisitadas.size());
             granjaId = nuevasNoVisitadas[pos];
             nuevasNoVisitadas.erase(nuevasNoVisitadas.begin() + pos);
         } else {
-            int pos = rand() % nuevasRutas[origenIdx].size();
+            int pos = aleatorio(nuevasRutas[origenIdx].size());
             granjaId = nuevasRutas[origenIdx][pos];
             nuevasRutas[origenIdx].erase(nuevasRutas[origenIdx].begin() + pos);
         }
@@ -216,7 +590,7 @@ Solucion Algoritmo::generarVecino(const Solucion& solActual) {
         if (destinoIdx == -1) {
             nuevasNoVisitadas.push_back(granjaId);
         } else {
-            int pos = nuevasRutas[destinoIdx].empty() ? 0 : rand() % (nuevasRutas[destinoIdx].size() + 1);
+            int pos = nuevasRutas[destinoIdx].empty() ? 0 : aleatorio(nuevasRutas[destinoIdx].size() + 1);
             nuevasRutas[destinoIdx].insert(nuevasRutas[destinoIdx].begin() + pos, granjaId);
         }
     }
@@ -224,6 +598,97 @@ Solucion Algoritmo::generarVecino(const Solucion& solActual) {
     return Solucion(nuevasRutas, nuevasNoVisitadas, inst);
 }
 
+// índice de rutas completo (al empezar, tras reinicios y migraciones, o fuera del SA)
+void Algoritmo::indexarRutas(const vector<vector<int>>& rutas) {
+    posicionesGranjas.assign(inst.granjas.size() + 2, {-1, -1});
+    cargasRutas.assign(rutas.size(), 0);
+    calidadesRutas.assign(rutas.size(), 'A');
+    for (size_t k = 0; k < rutas.size(); ++k) indexarRuta(rutas, k);
+}
+
+// re-indexa solo la ruta k: su carga, su calidad y la posición de sus granjas
+void Algoritmo::indexarRuta(const vector<vector<int>>& rutas, int k) {
+    cargasRutas[k] = 0;
+    calidadesRutas[k] = 'A';
+    for (size_t pos = 0; pos < rutas[k].size(); ++pos) {
+        const Nodo& nodo = inst.getNodo(rutas[k][pos]);
+        cargasRutas[k] += nodo.cantidadLeche;
+        calidadesRutas[k] = max(calidadesRutas[k], nodo.tipoLeche);
+        posicionesGranjas[nodo.id] = {k, (int)pos};
+    }
+}
+
+// reparación: mejor inserción factible de una granja no visitada
+bool Algoritmo::repararGranja(vector<vector<int>>& rutas, int granjaId) {
+    auto inicio = chrono::steady_clock::now();
+    estadisticasReparacion.llamadas++;
+
+    const Nodo& granja = inst.getNodo(granjaId);
+    const int planta = inst.planta.id;
+    const vector<int>& cargas = cargasRutas;
+    const vector<char>& calidades = calidadesRutas;
+
+    double mejorDelta = -numeric_limits<double>::max();
+    int mejorCamion = -1;
+    int mejorPosicion = -1;
+
+    // cambio de profit al insertar la granja antes de la posición 'pos' de la ruta k:
+    // ingreso con la nueva mezcla menos el ingreso actual, menos la distancia agregada
+    auto evaluar = [&](int k, int pos) {
+        if (cargas[k] + granja.cantidadLeche > inst.capacidadesCamiones[k]) return;
+        int nodoPrev = (pos == 0) ? planta : rutas[k][pos - 1];
+        int nodoSig = (pos == (int)rutas[k].size()) ? planta : rutas[k][pos];
+
+        char calidad = max(calidades[k], granja.tipoLeche);
+        double delta = (cargas[k] + granja.cantidadLeche) * inst.ingresosPorTipo.at(calidad)
+                     - cargas[k] * inst.ingresosPorTipo.at(calidades[k])
+                     - (inst.getDistancia(nodoPrev, granjaId) + inst.getDistancia(granjaId, nodoSig)
+                        - inst.getDistancia(nodoPrev, nodoSig));
+        if (delta > mejorDelta) {
+            mejorDelta = delta;
+            mejorCamion = k;
+            mejorPosicion = pos;
+        }
+    };
+
+    // 1. aristas que tocan a los nodos cercanos (si la planta es cercana, los extremos de cada
+    // ruta) y los camiones vacíos
+    indiceEspacial.vecinos(granja.x, granja.y, vecinosReparacion, granjaId, bufferVecinos);
+    for (int vecino : bufferVecinos) {
+        if (vecino == planta) {
+            for (size_t k = 0; k < rutas.size(); ++k) {
+                evaluar(k, 0);
+                if (!rutas[k].empty()) evaluar(k, rutas[k].size());
+            }
+        } else {
+            auto [k, pos] = posicionesGranjas[vecino];
+            // entrada vieja: la granja ya no está en esa posición (p.ej. quedó sin visitar)
+            if (k < 0 || pos >= (int)rutas[k].size() || rutas[k][pos] != vecino) continue;
+            evaluar(k, pos);
+            evaluar(k, pos + 1);
+        }
+    }
+    for (size_t k = 0; k < rutas.size(); ++k) {
+        if (rutas[k].empty()) evaluar(k, 0);
+    }
+
+    // 2. ningún camión cercano tiene espacio: todas las posiciones
+    if (mejorCamion == -1) {
+        estadisticasReparacion.busquedasCompletas++;
+        for (size_t k = 0; k < rutas.size(); ++k) {
+            for (int pos = 0; pos <= (int)rutas[k].size(); ++pos) evaluar(k, pos);
+        }
+    }
+
+    if (mejorCamion != -1) {
+        rutas[mejorCamion].insert(rutas[mejorCamion].begin() + mejorPosicion, granjaId);
+        rutasModificadas.push_back(mejorCamion);
+        estadisticasReparacion.exitos++;
+    }
+    estadisticasReparacion.segundos += chrono::duration<double>(chrono::steady_clock::now() - inicio).count();
+    return mejorCamion != -1;
+}
+
 // criterio de aceptación para SA
 bool Algoritmo::aceptarSolucion(double nuevoProfit, double profitActual, double temperatura) {
     // si la nueva solución es mejor, siempre se acepta
@@ -232,27 +697,25 @@ bool Algoritmo::aceptarSolucion(double nuevoProfit, double profitActual, double
     }
     // si es peor, se acepta con una probabilidad
     double prob = exp((nuevoProfit - profitActual) / temperatura);
-    return (double)rand() / RAND_MAX < prob;
+    return (double)rng() / mt19937::max() < prob;
 }
 
-// función de "energía" para SA, se quiere maximizar el profit.
-// incluye penalizaciones por infactibilidad.
-double Algoritmo::calcularEnergia(const Solucion& sol) {
-    double profit = sol.profit;
-    double penalizacion = 0.0;
+// mide cuánto viola una solución las restricciones de capacidad y cuotas
+Infactibilidad Algoritmo::medirInfactibilidad(const Solucion& sol) const {
+    Infactibilidad inf;
 
-    // 1. penalización por capacidad
-    for (int k = 0; k < sol.rutas.size(); ++k) {
+    // 1. exceso de capacidad
+    for (size_t k = 0; k < sol.rutas.size(); ++k) {
         int carga = 0;
         for (int granjaId : sol.rutas[k]) {
             carga += inst.getNodo(granjaId).cantidadLeche;
         }
         if (carga > inst.capacidadesCamiones[k]) {
-            penalizacion += (carga - inst.capacidadesCamiones[k]) * 15.0; // penalización baja por camiones
+            inf.excesoCapacidad += carga - inst.capacidadesCamiones[k];
         }
     }
 
-    // 2. penalización por cuotas
+    // 2. déficit de cuotas
     // (re-evaluar la leche final, ya que 'sol.esFactible' es solo un booleano)
     vector<int> lecheFinalPorTipo(inst.numTiposLeche, 0);
     for (const auto& ruta : sol.rutas) {
@@ -269,9 +732,147 @@ double Algoritmo::calcularEnergia(const Solucion& sol) {
 
     for (int i = 0; i < inst.numTiposLeche; ++i) {
         if (lecheFinalPorTipo[i] < inst.cuotasLeche[i]) {
-            penalizacion += (inst.cuotasLeche[i] - lecheFinalPorTipo[i]) * 500.0; // penalización alta para las cuotas
+            inf.deficitCuota += inst.cuotasLeche[i] - lecheFinalPorTipo[i];
         }
     }
-    
-    return profit - penalizacion;
-}
\ No newline at end of file
+
+    return inf;
+}
+
+// función de "energía" para SA, se quiere maximizar el profit.
+// incluye penalizaciones por infactibilidad con los pesos vigentes.
+double Algoritmo::calcularEnergia(const Solucion& sol, Infactibilidad& inf) {
+    inf = medirInfactibilidad(sol);
+    return energia(sol.profit, inf);
+}
+
+double Algoritmo::energia(double profit, const Infactibilidad& inf) const {
+    return profit - inf.excesoCapacidad * pesoCapacidad - inf.deficitCuota * pesoCuota;
+}
+
+double Algoritmo::calcularEnergia(const Solucion& sol) {
+    Infactibilidad inf;
+    return calcularEnergia(sol, inf);
+}
+
+// sube el peso de una restricción si la cadena la violó en más iteraciones de las buscadas
+// y lo baja en caso contrario, siempre dentro de [inicial*factorMinimo, inicial*factorMaximo]
+bool Algoritmo::ajustarPesos(int factiblesCapacidad, int factiblesCuota, int total) {
+    const ParametrosPenalizacion& p = parametrosPenalizacion;
+
+    auto ajustar = [&](double& peso, double inicial, int factibles) {
+        double anterior = peso;
+        if ((double)factibles / total < p.objetivoFactible) {
+            peso = min(peso * p.factorAjuste, inicial * p.factorMaximo);
+        } else {
+            peso = max(peso / p.factorAjuste, inicial * p.factorMinimo);
+        }
+        return peso != anterior;
+    };
+
+    bool cambioCapacidad = ajustar(pesoCapacidad, p.pesoCapacidadInicial, factiblesCapacidad);
+    bool cambioCuota = ajustar(pesoCuota, p.pesoCuotaInicial, factiblesCuota);
+    return cambioCapacidad || cambioCuota;
+}
+
+// una solución factible siempre es mejor que una infactible; entre iguales decide la energía.
+// así, bajar los pesos nunca hace que una infactible reemplace a la mejor factible.
+bool Algoritmo::esMejor(bool factibleA, double energiaA, bool factibleB, double energiaB) {
+    if (factibleA != factibleB) return factibleA;
+    return energiaA > energiaB;
+}
+
+// inserta 'sol' en el pool élite. si se parece demasiado a un élite existente, solo lo
+// reemplaza cuando es mejor; si no, entra en lugar del peor cuando el pool está lleno.
+// el pool queda ordenado de mejor a peor.
+void Algoritmo::actualizarElite(const Solucion& sol, const Infactibilidad& inf) {
+    int tamano = parametrosEstancamiento.tamanoElite;
+    if (tamano <= 0) return;
+
+    auto mejorQue = [&](const MiembroElite& a, const MiembroElite& b) {
+        return esMejor(a.sol.esFactible, energia(a.sol.profit, a.inf), b.sol.esFactible, energia(b.sol.profit, b.inf));
+    };
+
+    MiembroElite candidato{SolucionCompacta(poolSoluciones, sol), inf};
+    for (auto& e : elite) {
+        if (distanciaSoluciones(candidato.sol, e.sol) < parametrosEstancamiento.diversidadMinima) {
+            if (!mejorQue(candidato, e)) return;
+            e = std::move(candidato);
+            sort(elite.begin(), elite.end(), mejorQue);
+            return;
+        }
+    }
+
+    if ((int)elite.size() < tamano) {
+        elite.push_back(std::move(candidato));
+    } else if (mejorQue(candidato, elite.back())) {
+        elite.back() = std::move(candidato);
+    } else {
+        return;
+    }
+    sort(elite.begin(), elite.end(), mejorQue);
+}
+
+double Algoritmo::distanciaSoluciones(const SolucionCompacta& a, const SolucionCompacta& b) const {
+    auto aristas = [&](const SolucionCompacta& sol) {
+        set<pair<int, int>> conjunto;
+        for (int k = 0; k < sol.numRutas(); ++k) {
+            if (sol.inicioRuta(k) == sol.finRuta(k)) continue;
+            int previo = inst.planta.id;
+            for (const uint16_t* granja = sol.inicioRuta(k); granja != sol.finRuta(k); ++granja) {
+                int granjaId = *granja;
+                conjunto.insert({min(previo, granjaId), max(previo, granjaId)});
+                previo = granjaId;
+            }
+            conjunto.insert({min(previo, inst.planta.id), max(previo, inst.planta.id)});
+        }
+        return conjunto;
+    };
+
+    set<pair<int, int>> aristasA = aristas(a);
+    set<pair<int, int>> aristasB = aristas(b);
+    if (aristasA.empty()) return aristasB.empty() ? 0.0 : 1.0;
+
+    int distintas = 0;
+    for (const auto& arista : aristasA) {
+        if (!aristasB.count(arista)) distintas++;
+    }
+    return (double)distintas / aristasA.size();
+}
+
+// migración del modelo de islas. los migrantes siempre alimentan el pool élite; si alguno es
+// mejor que la mejor solución local, la cadena continúa desde él (política "adoptar si mejora").
+bool Algoritmo::migrar(Solucion& solActual, Solucion& mejorSolucion) {
+    canalMigracion->publicar({idIsla, mejorSolucion.profit, mejorSolucion.rutas, mejorSolucion.granjasNoVisitadas});
+
+    bool adoptado = false;
+    for (const Migrante& m : canalMigracion->recibir()) {
+        // validar que el migrante sea una asignación completa de las granjas de esta instancia
+        if ((int)m.rutas.size() != inst.numCamiones) continue;
+        vector<int> vistas(inst.numNodos + 1, 0);
+        bool valido = true;
+        auto marcar = [&](int id) {
+            if (id < 1 || id > inst.numNodos || id == inst.planta.id || vistas[id]++) valido = false;
+        };
+        for (const auto& ruta : m.rutas) for (int id : ruta) marcar(id);
+        for (int id : m.granjasNoVisitadas) marcar(id);
+        int asignadas = 0;
+        for (int v : vistas) asignadas += v;
+        if (!valido || asignadas != (int)inst.granjas.size()) continue;
+
+        migrantesRecibidos++;
+        Solucion candidata(m.rutas, m.granjasNoVisitadas, inst);
+        Infactibilidad infCandidata;
+        calcularEnergia(candidata, infCandidata);
+        actualizarElite(candidata, infCandidata);
+
+        if (esMejor(candidata.esFactible, calcularEnergia(candidata), mejorSolucion.esFactible, calcularEnergia(mejorSolucion))) {
+            mejorSolucion = candidata;
+            solActual = candidata;
+            adoptado = true;
+        }
+    }
+
+    if (adoptado) migrantesAdoptados++;
+    return adoptado;
+}
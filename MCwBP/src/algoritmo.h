@@ -1,25 +1,251 @@
 #pragma once
 #include "instancia.h"
 #include "solucion.h"
+#include "solucion_compacta.h"
+#include "indice_espacial.h"
+#include <random>
+#include <string>
+
+class CanalMigracion;
+struct Checkpoint;
+struct CotaSuperior;
+class ProgresoSA;
+class TokenCancelacion;
+
+// eventos del control de estancamiento que quedan registrados en el historial
+enum class EventoSA : char {
+    Ninguno,
+    Recalentamiento, // la temperatura se elevó a un valor calculado
+    Reinicio         // la cadena se reinició desde una solución del pool élite
+};
+
+// registro de convergencia: iteración, profit de la mejor solución, pesos de penalización vigentes
+// y evento de estancamiento (si ocurrió en esa iteración)
+struct RegistroConvergencia {
+    long long iteracion;
+    double profit;
+    double pesoCapacidad;
+    double pesoCuota;
+    EventoSA evento = EventoSA::Ninguno;
+};
+
+const char* nombreEvento(EventoSA evento);
+
+// medida de infactibilidad de una solución (en unidades de leche)
+struct Infactibilidad {
+    int excesoCapacidad = 0; // suma de exceso de carga sobre la capacidad de cada camión
+    int deficitCuota = 0;    // suma de leche faltante para cumplir cada cuota
+};
+
+// estadísticas del movimiento de reparación (mejor inserción de una granja no visitada)
+struct EstadisticasReparacion {
+    long long llamadas = 0;
+    long long exitos = 0;             // granjas que se pudieron insertar
+    long long busquedasCompletas = 0; // sin posición factible cerca: se recorrieron todas las rutas
+    double segundos = 0.0;            // tiempo total dentro de la reparación
+
+    double microsegundosPorLlamada() const { return llamadas ? segundos * 1e6 / llamadas : 0.0; }
+};
+
+// parámetros de la penalización adaptativa
+struct ParametrosPenalizacion {
+    bool adaptativa = true;
+    double pesoCapacidadInicial = 15.0;  // penalización por unidad de exceso de capacidad
+    double pesoCuotaInicial = 500.0;     // penalización por unidad de déficit de cuota
+    int ventana = 1000;                  // iteraciones entre ajustes de los pesos
+    double objetivoFactible = 0.5;       // fracción de iteraciones factibles buscada en cada ventana
+    double factorAjuste = 1.1;           // multiplicador aplicado al subir/bajar un peso
+    double factorMinimo = 0.1;           // cota inferior de cada peso (relativa al inicial)
+    double factorMaximo = 100.0;         // cota superior de cada peso (relativa al inicial)
+};
+
+// parámetros de la detección de estancamiento
+struct ParametrosEstancamiento {
+    bool activo = true;
+    int ventanaMinima = 200000;        // iteraciones mínimas sin mejora para declarar estancamiento
+    double fraccionVentana = 0.1;      // ventana relativa a las iteraciones ya realizadas
+    double probRecalentamiento = 0.3;  // prob. de aceptar un empeoramiento típico tras recalentar
+    int tamanoElite = 5;               // soluciones guardadas en el pool élite
+    double diversidadMinima = 0.15;    // fracción mínima de aristas distintas entre dos élites
+};
+
+// resultado de la calibración automática de temperaturas
+struct CalibracionTemperatura {
+    double tempInicial;
+    double tempFinal;
+    int muestras;          // vecinos muestreados
+    int empeoramientos;    // cuántos de ellos empeoraban la energía
+    double deltaAlto;      // percentil alto de los empeoramientos (incluye saltos de penalización)
+    double deltaBajo;      // percentil bajo de los empeoramientos (ajustes finos de ruta)
+};
+
+// parámetros del esquema de enfriamiento
+struct ParametrosSA {
+    double tempInicial = 100000.0;     // temperatura inicial
+    double tempFinal = 1.0;            // criterio de parada
+    double tasaEnfriamiento = 0.9999995; // velocidad de enfriamiento
+
+    // calibración automática: reemplaza tempInicial/tempFinal por valores estimados de la
+    // instancia, manteniendo el presupuesto de iteraciones del esquema anterior
+    bool calibrarTemperatura = true;
+    int muestrasCalibracion = 2000;
+    double probAceptacionInicial = 0.5;   // prob. de aceptar un empeoramiento grande (percentil 90) al inicio
+    double probAceptacionFinal = 0.01;    // prob. de aceptar un empeoramiento pequeño (percentil 10) al final
+};
+
+// checkpoints periódicos del SA (desactivados si 'ruta' está vacía)
+struct ParametrosCheckpoint {
+    string ruta;                     // archivo de checkpoint; el historial va en '<ruta>.hist'
+    long long intervalo = 1000000;   // iteraciones entre checkpoints
+    bool borrarAlTerminar = true;    // eliminar el checkpoint cuando la ejecución termina
+};
+
+// estado del bucle de SA. junto con el generador aleatorio, los pesos, el pool élite y las
+// estadísticas de Algoritmo, basta para continuar una ejecución de forma idéntica.
+struct EstadoSA {
+    Solucion solActual;
+    Solucion mejorSolucion;          // durante el bucle vive compacta; se materializa en cada checkpoint y al terminar
+    Infactibilidad infActual;
+    double energiaActual = 0.0;
+    double mejorEnergia = 0.0;
+
+    double tempInicial = 0.0;
+    double tempFinal = 0.0;
+    double temperatura = 0.0;
+    double tasaEnfriamiento = 0.0;   // puede cambiar al recalentar
+    long long maxIteraciones = 0;
+    long long iteracion = 0;
+
+    // ventana de la penalización adaptativa
+    int factiblesCapacidad = 0;
+    int factiblesCuota = 0;
+    int iteracionesVentana = 0;
+
+    // control de estancamiento
+    long long iteracionUltimaMejora = 0;
+    bool mejoroDesdeUltimoEvento = true;
+    double deltaPromedio = 0.0;      // promedio móvil de los empeoramientos propuestos
+
+    double segundosTranscurridos = 0.0; // tiempo de pared acumulado hasta el último checkpoint
+};
 
 class Algoritmo {
+    friend struct AccesoBench; // micro-benchmarks de los núcleos privados (src/bench.cpp)
+
 private:
     const Instancia& inst; // feferencia a la instancia
     long seed; // semilla para aleatoriedad
+    mt19937 rng; // generador aleatorio (su estado se guarda en los checkpoints)
 
 public:
     Algoritmo(const Instancia& inst, long seed);
 
-    vector<pair<int, double>> historialConvergencia; // <Iteración, Costo/Profit>
+    // semilla de la ejecución (al reanudar, la del checkpoint)
+    long getSeed() const { return seed; }
+
+    vector<RegistroConvergencia> historialConvergencia;
+
+    ParametrosPenalizacion parametrosPenalizacion;
+    ParametrosEstancamiento parametrosEstancamiento;
+
+    // cantidad de eventos de estancamiento en la última ejecución
+    int numRecalentamientos = 0;
+    int numReinicios = 0;
+
+    // momento en que la cadena encontró su primera solución factible (-1 si nunca)
+    double tiempoPrimerFactible = -1.0; // segundos desde el inicio de SA (incluye el greedy)
+    long long iteracionPrimerFactible = -1;
+
+    // iteraciones de SA efectivamente realizadas en la última ejecución
+    long long iteracionesRealizadas = 0;
+
+    // última calibración aplicada por ejecutarSimulatedAnnealing(const ParametrosSA&)
+    bool temperaturaCalibrada = false;
+    CalibracionTemperatura calibracion;
+    double tasaCalibrada = 0.0;
+
+    // modelo de islas: si hay canal, cada 'intervaloMigracion' iteraciones se publica la mejor
+    // solución y se incorporan las recibidas de otras islas
+    CanalMigracion* canalMigracion = nullptr;
+    int idIsla = 0;
+    int intervaloMigracion = 100000;
+    int migrantesRecibidos = 0;
+    int migrantesAdoptados = 0;
+
+    ParametrosCheckpoint parametrosCheckpoint;
+
+    // presupuesto de tiempo de pared del bucle de SA en segundos (0: sin límite). el enfriamiento
+    // se re-ajusta para llegar a tempFinal cuando se acaba el tiempo o las iteraciones, lo que ocurra antes.
+    double limiteSegundos = 0.0;
+
+    // progreso en vivo y cancelación (opcionales): el progreso se publica cada 'intervaloProgreso'
+    // iteraciones y el token se consulta en cada una
+    ProgresoSA* progreso = nullptr;
+    const TokenCancelacion* cancelacion = nullptr;
+    int intervaloProgreso = 1024;
+    bool cancelada = false; // la última ejecución terminó por cancelación
+
+    // terminación temprana (opcional): el SA se detiene cuando la mejor solución es factible y su
+    // brecha respecto de la cota superior es a lo más 'epsilonBrecha'
+    const CotaSuperior* cotaSuperior = nullptr;
+    double epsilonBrecha = 0.0;
+    bool terminadaPorBrecha = false; // la última ejecución terminó por alcanzar la brecha
+
+    // reparación: con probabilidad 1/'frecuenciaReparacion' (si hay granjas no visitadas) el vecino
+    // inserta una de ellas en su mejor posición factible, evaluando solo las aristas que tocan a
+    // sus 'vecinosReparacion' nodos más cercanos
+    int frecuenciaReparacion = 4;
+    int vecinosReparacion = 8;
+    EstadisticasReparacion estadisticasReparacion; // de la última ejecución
+
+    // imprimir en cout el inicio y fin de cada ejecución de SA
+    bool mostrarLog = true;
 
     // solución inicial con greedy
     Solucion generarSolucionInicialGreedy();
 
+    // mide el exceso de capacidad y el déficit de cuotas de una solución
+    Infactibilidad medirInfactibilidad(const Solucion& sol) const;
+
+    // inserción greedy (cheapest insertion respetando capacidades) de 'granjas' en rutas
+    // que pueden traer granjas ya asignadas. las que no caben van a 'noVisitadas'.
+    void insertarGranjasGreedy(vector<vector<int>>& rutas, vector<Nodo> granjas, vector<int>& noVisitadas) const;
+
+    // estima la distribución de deltas de energía muestreando vecinos de 'base' y fija
+    // las temperaturas para que el percentil alto de los empeoramientos se acepte con
+    // probInicial al comienzo y el percentil bajo se acepte con probFinal al terminar
+    CalibracionTemperatura calibrarTemperaturas(const Solucion& base, int muestras = 2000,
+                                                double probInicial = 0.5, double probFinal = 0.01,
+                                                double percentilAlto = 0.9, double percentilBajo = 0.1);
+
     // función principal que ejecutará la metaheurística
     Solucion ejecutarSimulatedAnnealing(double tempInicial, double tempFinal, double tasaEnfriamiento);
 
+    // igual que la anterior, partiendo de una solución dada en vez del greedy (arranque en caliente)
+    Solucion ejecutarSimulatedAnnealing(const Solucion& solInicial, double tempInicial, double tempFinal, double tasaEnfriamiento);
+
+    // igual que la anterior, pero calibrando las temperaturas si los parámetros lo piden.
+    // si hay checkpoint configurado y el archivo existe, continúa desde él.
+    Solucion ejecutarSimulatedAnnealing(const ParametrosSA& params);
+
+    // continúa una ejecución interrumpida desde un checkpoint
+    Solucion reanudarSimulatedAnnealing(const string& pathCheckpoint);
+
 private:
     // SA
+    EstadoSA estado;
+    size_t cursorHistorial = 0; // registros del historial ya enviados al escritor de checkpoints
+
+    // bucle principal, a partir de 'estado'
+    Solucion continuarSimulatedAnnealing();
+
+    // copia / restaura todo lo que necesita el bucle para continuar de forma idéntica
+    Checkpoint capturarCheckpoint();
+    void restaurarCheckpoint(const Checkpoint& ckpt);
+
+    // entero uniforme en [0, n)
+    int aleatorio(int n);
+
     // generar un vecino de la solución actual
     Solucion generarVecino(const Solucion& solActual);
 
@@ -31,10 +257,66 @@ private:
     // (Ej. invertir un segmento de una ruta)
     vector<vector<int>> movimiento_2Opt(vector<vector<int>> rutas);
 
+    // inserta 'granjaId' en la posición que más aumenta el profit sin exceder la capacidad del
+    // camión (la mezcla de leche incluida). se miran primero las aristas de las rutas que tocan
+    // a los nodos cercanos y, si ninguna admite la granja, todas. false si no cabe en ningún camión.
+    // 'rutas' debe ser la solución descrita por el índice de rutas.
+    bool repararGranja(vector<vector<int>>& rutas, int granjaId);
+
+    IndiceEspacial indiceEspacial;
+    vector<int> bufferVecinos;               // nodos cercanos de la última consulta
+
+    // índice de rutas de la solución actual del SA, para que la reparación no recorra todas las
+    // granjas: (camión, posición) de cada granja por ID y carga y calidad más baja de cada ruta.
+    // al aceptar un vecino se re-indexan solo las rutas que cambió; la entrada de una granja que
+    // salió de las rutas queda vieja y se descarta al consultarla.
+    vector<pair<int, int>> posicionesGranjas;
+    vector<int> cargasRutas;
+    vector<char> calidadesRutas;
+    bool indiceRutasValido = false; // el índice describe a estado.solActual
+    vector<int> rutasModificadas;   // rutas que cambió el último vecino generado
+
+    void indexarRutas(const vector<vector<int>>& rutas);
+    void indexarRuta(const vector<vector<int>>& rutas, int k);
+
 
     // criterio de aceptación
     bool aceptarSolucion(double nuevoProfit, double profitActual, double temperatura);
 
-    // función para calcular la "energía" de una solución (a minimizar)
+    // pesos de penalización vigentes (se ajustan durante SA si la penalización es adaptativa)
+    double pesoCapacidad;
+    double pesoCuota;
+
+    // función para calcular la "energía" de una solución (a maximizar)
     double calcularEnergia(const Solucion& sol);
+    double calcularEnergia(const Solucion& sol, Infactibilidad& inf);
+    double energia(double profit, const Infactibilidad& inf) const; // con la infactibilidad ya medida
+
+    // ajusta los pesos según la fracción de iteraciones factibles de la última ventana.
+    // devuelve true si algún peso cambió.
+    bool ajustarPesos(int factiblesCapacidad, int factiblesCuota, int total);
+
+    // orden lexicográfico: primero factibilidad, luego energía
+    static bool esMejor(bool factibleA, double energiaA, bool factibleB, double energiaB);
+
+    // almacenamiento de las soluciones guardadas (mejor y élite) en formato compacto
+    PoolSoluciones poolSoluciones;
+
+    // pool élite: pocas soluciones buenas y diversas entre sí, usadas para reiniciar la cadena.
+    // la infactibilidad no depende de los pesos, así que se guarda para re-calcular la energía.
+    struct MiembroElite {
+        SolucionCompacta sol;
+        Infactibilidad inf;
+    };
+    vector<MiembroElite> elite;
+
+    // intenta agregar una solución al pool élite respetando la diversidad mínima
+    void actualizarElite(const Solucion& sol, const Infactibilidad& inf);
+
+    // fracción de aristas (incluyendo las de la planta) de 'a' que no están en 'b'
+    double distanciaSoluciones(const SolucionCompacta& a, const SolucionCompacta& b) const;
+
+    // publica la mejor solución e incorpora las de otras islas (élite y, si son mejores, la cadena).
+    // devuelve true si se adoptó algún migrante como solución actual.
+    bool migrar(Solucion& solActual, Solucion& mejorSolucion);
 };
\ No newline at end of file
@@ -18,6 +18,8 @@ struct Resultado {
     long profitFin = 0;
     bool factibleFin = false;
     double tiempo = 0.0;
+    double tiempoPrimerFactible = -1.0; // -1 si SA nunca encontró una solución factible
+    double brecha = -1.0;               // % respecto de la cota superior (-1 si no se informó)
     
     bool leidoInstancia = false;
     bool leidoProfitIni = false;
@@ -89,6 +91,8 @@ int main() {
     
     // regex para capturarel tiempo
     regex regex_tiempo("Tiempo:\\s*([0-9\\.]+)\\s*s");
+    regex regex_primer_factible("Primer factible:\\s*([0-9\\.]+)\\s*s");
+    regex regex_brecha("Brecha:\\s*([0-9\\.]+)%");
 
     if (!fs::exists(resultsDir)) {
         cerr << "Error: No existe el directorio results/" << endl;
@@ -99,6 +103,10 @@ int main() {
     int factibleIniCount = 0;
     int factibleFinCount = 0;
     double tiempoTotalAcumulado = 0.0;
+    int primerFactibleCount = 0;
+    double tiempoPrimerFactibleAcumulado = 0.0;
+    int brechaCount = 0;
+    double brechaAcumulada = 0.0;
 
     for (const auto& entry : fs::directory_iterator(resultsDir)) {
         if (entry.path().extension() != ".txt") continue;
@@ -115,6 +123,14 @@ int main() {
             res.tiempo = stod(m_time[1].str());
             res.leidoTiempo = true;
         }
+        smatch m_primer;
+        if (regex_search(full_content, m_primer, regex_primer_factible)) {
+            res.tiempoPrimerFactible = stod(m_primer[1].str());
+        }
+        smatch m_brecha;
+        if (regex_search(full_content, m_brecha, regex_brecha)) {
+            res.brecha = stod(m_brecha[1].str());
+        }
 
         // vuelve al inicio del archivo para parsear línea por línea
         file.clear();
@@ -177,6 +193,14 @@ int main() {
             if (res.factibleIni) factibleIniCount++;
             if (res.factibleFin) factibleFinCount++;
             tiempoTotalAcumulado += res.tiempo;
+            if (res.tiempoPrimerFactible >= 0) {
+                primerFactibleCount++;
+                tiempoPrimerFactibleAcumulado += res.tiempoPrimerFactible;
+            }
+            if (res.brecha >= 0) {
+                brechaCount++;
+                brechaAcumulada += res.brecha;
+            }
         } else {
             cerr << "Advertencia: Parseo incompleto en " << entry.path().filename() << endl;
         }
@@ -191,14 +215,24 @@ int main() {
     double pctFin = (double)factibleFinCount / totalCount * 100.0;
 
     cout << "\nResultados Procesados: " << totalCount << endl;
+    cout << "Factibilidad Greedy: " << fixed << setprecision(1) << pctIni << "%, SA: " << pctFin << "%" << endl;
+    if (primerFactibleCount > 0) {
+        cout << "Tiempo medio al primer factible: " << setprecision(3)
+             << tiempoPrimerFactibleAcumulado / primerFactibleCount << "s ("
+             << primerFactibleCount << "/" << totalCount << " instancias)" << endl;
+    }
+    if (brechaCount > 0) {
+        cout << "Brecha media a la cota superior: " << setprecision(2)
+             << brechaAcumulada / brechaCount << "% (" << brechaCount << "/" << totalCount << " instancias)" << endl;
+    }
     generarGraficoBarrasSVG(pctIni, pctFin, graficosDir + "comparacion_factibilidad.svg");
 
     cout << "\n--- TABLA LATEX ---\n" << endl;
     cout << "\\begin{table}[H]" << endl;
     cout << "\\centering" << endl;
-    cout << "\\begin{tabular}{|l|c|c|c|c|c|}" << endl;
+    cout << "\\begin{tabular}{|l|c|c|c|c|c|c|}" << endl;
     cout << "\\hline" << endl;
-    cout << "\\textbf{Instancia} & \\textbf{Profit Ini.} & \\textbf{Fact. Ini.} & \\textbf{Profit Fin.} & \\textbf{Fact. Fin.} & \\textbf{Tiempo (s)} \\\\ \\hline" << endl;
+    cout << "\\textbf{Instancia} & \\textbf{Profit Ini.} & \\textbf{Fact. Ini.} & \\textbf{Profit Fin.} & \\textbf{Fact. Fin.} & \\textbf{Brecha (\\%)} & \\textbf{Tiempo (s)} \\\\ \\hline" << endl;
 
     sort(resultados.begin(), resultados.end(), [](const Resultado& a, const Resultado& b) {
         return a.instancia < b.instancia;
@@ -216,13 +250,15 @@ int main() {
              << r.profitIni << " & " 
              << (r.factibleIni ? "Si" : "No") << " & " 
              << "\\textbf{" << r.profitFin << "} & " 
-             << "\\textbf{" << (r.factibleFin ? "Si" : "No") << "} & " 
-             << fixed << setprecision(2) << r.tiempo << " \\\\" << endl;
+             << "\\textbf{" << (r.factibleFin ? "Si" : "No") << "} & ";
+        if (r.brecha >= 0) cout << fixed << setprecision(2) << r.brecha << " & ";
+        else cout << "- & ";
+        cout << fixed << setprecision(2) << r.tiempo << " \\\\" << endl;
     }
     
     // totales
     cout << "\\hline" << endl;
-    cout << "\\textbf{Total} & - & - & - & - & \\textbf{" << fixed << setprecision(2) << tiempoTotalAcumulado << "} \\\\" << endl;
+    cout << "\\textbf{Total} & - & - & - & - & - & \\textbf{" << fixed << setprecision(2) << tiempoTotalAcumulado << "} \\\\" << endl;
 
     cout << "\\hline" << endl;
     cout << "\\end{tabular}" << endl;
@@ -0,0 +1,319 @@
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <chrono>
+#include <atomic>
+#include <algorithm>
+#include <cmath>
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <filesystem>
+#include <new>
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <linux/perf_event.h>
+
+#include "algoritmo.h"
+
+using namespace std;
+namespace fs = std::filesystem;
+
+// micro-benchmarks de los núcleos del solver sobre soluciones de las instancias reales.
+// uso: bin/bench [--instancia archivo]... [--repeticiones R] [--calentamiento W]
+//                [--muestra-us U] [--soluciones P] [--semilla S] [--salida archivo.json]
+// cada núcleo se mide en R muestras de 'lote' llamadas (el lote se ajusta para que una muestra
+// dure al menos U microsegundos) tras W muestras de calentamiento. se informan mediana, MAD y
+// mínimo del tiempo por llamada, la mediana de ciclos (si perf_event está disponible) y las
+// asignaciones de memoria por llamada. la salida es JSON, para comparar dos corridas.
+
+// --- conteo de asignaciones: reemplaza el operator new global de este ejecutable ---
+
+static atomic<unsigned long long> asignaciones{0};
+static atomic<unsigned long long> bytesAsignados{0};
+
+void* operator new(size_t n) {
+    asignaciones.fetch_add(1, memory_order_relaxed);
+    bytesAsignados.fetch_add(n, memory_order_relaxed);
+    if (void* p = malloc(n ? n : 1)) return p;
+    throw bad_alloc();
+}
+void* operator new[](size_t n) { return operator new(n); }
+// noinline: si se expanden junto al new, gcc advierte (por error) que free no corresponde a new
+[[gnu::noinline]] void operator delete(void* p) noexcept { free(p); }
+[[gnu::noinline]] void operator delete[](void* p) noexcept { free(p); }
+[[gnu::noinline]] void operator delete(void* p, size_t) noexcept { free(p); }
+[[gnu::noinline]] void operator delete[](void* p, size_t) noexcept { free(p); }
+
+// --- ciclos: contador de hardware del proceso (solo espacio de usuario) ---
+
+class ContadorCiclos {
+public:
+    ContadorCiclos() {
+        perf_event_attr attr;
+        memset(&attr, 0, sizeof(attr));
+        attr.type = PERF_TYPE_HARDWARE;
+        attr.size = sizeof(attr);
+        attr.config = PERF_COUNT_HW_CPU_CYCLES;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        fd = syscall(__NR_perf_event_open, &attr, 0, -1, -1, 0);
+        if (fd >= 0) ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+        else error = strerror(errno);
+    }
+    ~ContadorCiclos() { if (fd >= 0) close(fd); }
+    ContadorCiclos(const ContadorCiclos&) = delete;
+    ContadorCiclos& operator=(const ContadorCiclos&) = delete;
+
+    bool disponible() const { return fd >= 0; }
+    const string& motivo() const { return error; }
+
+    unsigned long long leer() const {
+        unsigned long long valor = 0;
+        if (fd < 0 || read(fd, &valor, sizeof(valor)) != sizeof(valor)) return 0;
+        return valor;
+    }
+
+private:
+    int fd = -1;
+    string error;
+};
+
+// --- estadística ---
+
+static double mediana(vector<double> v) {
+    if (v.empty()) return 0.0;
+    size_t m = v.size() / 2;
+    nth_element(v.begin(), v.begin() + m, v.end());
+    double med = v[m];
+    if (v.size() % 2 == 0) med = (med + *max_element(v.begin(), v.begin() + m)) / 2.0;
+    return med;
+}
+
+// desviación absoluta mediana: robusta ante las muestras interrumpidas por el sistema
+static double mad(const vector<double>& v) {
+    double med = mediana(v);
+    vector<double> desvios;
+    for (double x : v) desvios.push_back(fabs(x - med));
+    return mediana(desvios);
+}
+
+struct Medicion {
+    string nucleo;
+    long long lote = 0;
+    double medianaNs = 0.0, madNs = 0.0, minNs = 0.0;
+    double medianaCiclos = -1.0; // -1: sin perf_event
+    double asignacionesPorLlamada = 0.0;
+    double bytesPorLlamada = 0.0;
+};
+
+struct Opciones {
+    int repeticiones = 31;
+    int calentamiento = 5;
+    double muestraMicros = 200.0;
+};
+
+// evita que el compilador descarte los resultados de los núcleos
+static volatile double sumidero;
+
+// mide 'nucleo(i)' (i: número de llamada) según las opciones
+template <typename F>
+static Medicion medir(const string& nombre, const Opciones& op, const ContadorCiclos& ciclos, F&& nucleo) {
+    using reloj = chrono::steady_clock;
+    long long i = 0;
+    auto muestra = [&](long long lote) {
+        auto inicio = reloj::now();
+        for (long long j = 0; j < lote; ++j) nucleo(i++);
+        return chrono::duration<double, nano>(reloj::now() - inicio).count();
+    };
+
+    // lote: se duplica hasta que una muestra dura lo pedido (también sirve de calentamiento)
+    long long lote = 1;
+    while (lote < (1LL << 24) && muestra(lote) < op.muestraMicros * 1000.0) lote *= 2;
+    for (int w = 0; w < op.calentamiento; ++w) muestra(lote);
+
+    vector<double> tiempos, ciclosPorLlamada;
+    tiempos.reserve(op.repeticiones);
+    ciclosPorLlamada.reserve(op.repeticiones);
+    unsigned long long asignacionesInicio = asignaciones.load(), bytesInicio = bytesAsignados.load();
+    for (int r = 0; r < op.repeticiones; ++r) {
+        unsigned long long c0 = ciclos.leer();
+        double ns = muestra(lote);
+        unsigned long long c1 = ciclos.leer();
+        tiempos.push_back(ns / lote);
+        if (ciclos.disponible()) ciclosPorLlamada.push_back((double)(c1 - c0) / lote);
+    }
+    unsigned long long asignacionesFin = asignaciones.load(), bytesFin = bytesAsignados.load();
+    double llamadas = (double)op.repeticiones * lote;
+
+    Medicion m;
+    m.nucleo = nombre;
+    m.lote = lote;
+    m.medianaNs = mediana(tiempos);
+    m.madNs = mad(tiempos);
+    m.minNs = *min_element(tiempos.begin(), tiempos.end());
+    if (ciclos.disponible()) m.medianaCiclos = mediana(ciclosPorLlamada);
+    m.asignacionesPorLlamada = (asignacionesFin - asignacionesInicio) / llamadas;
+    m.bytesPorLlamada = (bytesFin - bytesInicio) / llamadas;
+    return m;
+}
+
+// acceso a los métodos privados que se miden (friend de Algoritmo e Instancia)
+struct AccesoBench {
+    static Solucion generarVecino(Algoritmo& algo, const Solucion& sol) { return algo.generarVecino(sol); }
+    static double calcularEnergia(Algoritmo& algo, const Solucion& sol) { return algo.calcularEnergia(sol); }
+    static void calcularMatrizDistancias(Instancia& inst) { inst.calcularMatrizDistancias(); }
+};
+
+// soluciones de entrada: la greedy y las que visita un recorrido de vecinos aleatorios desde
+// ella (factibles e infactibles, como las que ve el SA)
+static vector<Solucion> generarSoluciones(const Instancia& inst, Algoritmo& algo, int cantidad) {
+    vector<Solucion> soluciones;
+    Solucion actual = algo.generarSolucionInicialGreedy();
+    soluciones.push_back(actual);
+    while ((int)soluciones.size() < cantidad) {
+        for (int paso = 0; paso < 50; ++paso) actual = AccesoBench::generarVecino(algo, actual);
+        soluciones.push_back(actual);
+    }
+    return soluciones;
+}
+
+static string escaparJSON(const string& s) {
+    string salida;
+    for (char c : s) {
+        if (c == '"' || c == '\\') salida += '\\';
+        salida += c;
+    }
+    return salida;
+}
+
+int main(int argc, char* argv[]) {
+    const string instanciaDir = "instancias/";
+
+    vector<string> pathsInstancias;
+    Opciones op;
+    int numSoluciones = 64;
+    long semilla = 12345;
+    string pathSalida;
+
+    for (int i = 1; i < argc; ++i) {
+        string arg = argv[i];
+        if (arg == "--instancia" && i + 1 < argc) pathsInstancias.push_back(argv[++i]);
+        else if (arg == "--repeticiones" && i + 1 < argc) op.repeticiones = stoi(argv[++i]);
+        else if (arg == "--calentamiento" && i + 1 < argc) op.calentamiento = stoi(argv[++i]);
+        else if (arg == "--muestra-us" && i + 1 < argc) op.muestraMicros = stod(argv[++i]);
+        else if (arg == "--soluciones" && i + 1 < argc) numSoluciones = stoi(argv[++i]);
+        else if (arg == "--semilla" && i + 1 < argc) semilla = stol(argv[++i]);
+        else if (arg == "--salida" && i + 1 < argc) pathSalida = argv[++i];
+        else {
+            cerr << "Uso: " << argv[0] << " [--instancia archivo]... [--repeticiones R] [--calentamiento W]"
+                 << " [--muestra-us U] [--soluciones P] [--semilla S] [--salida archivo.json]" << endl;
+            return 1;
+        }
+    }
+    if (op.repeticiones < 1 || op.calentamiento < 0 || numSoluciones < 1) {
+        cerr << "Se requiere al menos una repetición y una solución." << endl;
+        return 1;
+    }
+    if (pathsInstancias.empty()) {
+        for (const auto& entry : fs::directory_iterator(instanciaDir)) {
+            if (entry.path().extension() == ".txt") pathsInstancias.push_back(entry.path().string());
+        }
+        sort(pathsInstancias.begin(), pathsInstancias.end());
+    }
+
+    ContadorCiclos ciclos;
+    if (!ciclos.disponible()) cerr << "perf_event no disponible (" << ciclos.motivo() << "): sin conteo de ciclos" << endl;
+
+    stringstream json;
+    json << fixed << setprecision(3);
+    json << "{\n";
+    json << "  \"compilador\": \"" << escaparJSON(__VERSION__) << "\",\n";
+    json << "  \"fecha\": " << time(nullptr) << ",\n";
+    json << "  \"perf_event\": " << (ciclos.disponible() ? "true" : "false") << ",\n";
+    json << "  \"repeticiones\": " << op.repeticiones << ",\n";
+    json << "  \"calentamiento\": " << op.calentamiento << ",\n";
+    json << "  \"muestra_us\": " << op.muestraMicros << ",\n";
+    json << "  \"soluciones\": " << numSoluciones << ",\n";
+    json << "  \"semilla\": " << semilla << ",\n";
+    json << "  \"resultados\": [";
+
+    bool primero = true;
+    for (const string& path : pathsInstancias) {
+        string nombre = fs::path(path).filename().string();
+        try {
+            Instancia inst(path);
+            Algoritmo algo(inst, semilla);
+            algo.mostrarLog = false;
+            vector<Solucion> soluciones = generarSoluciones(inst, algo, numSoluciones);
+            const size_t p = soluciones.size();
+
+            // pares de nodos consecutivos de las rutas (planta incluida): el acceso real del evaluador
+            vector<pair<int, int>> pares;
+            for (const Solucion& sol : soluciones) {
+                for (const auto& ruta : sol.rutas) {
+                    int previo = inst.planta.id;
+                    for (int id : ruta) { pares.emplace_back(previo, id); previo = id; }
+                    if (!ruta.empty()) pares.emplace_back(previo, inst.planta.id);
+                }
+            }
+            if (pares.empty()) pares.emplace_back(inst.planta.id, inst.planta.id);
+
+            vector<Medicion> mediciones;
+            vector<Solucion> copias = soluciones;
+            mediciones.push_back(medir("Solucion::evaluar", op, ciclos, [&](long long i) {
+                Solucion& sol = copias[i % p];
+                sol.evaluar(inst);
+                sumidero = sol.profit;
+            }));
+            mediciones.push_back(medir("Algoritmo::calcularEnergia", op, ciclos, [&](long long i) {
+                sumidero = AccesoBench::calcularEnergia(algo, soluciones[i % p]);
+            }));
+            mediciones.push_back(medir("Algoritmo::generarVecino", op, ciclos, [&](long long i) {
+                sumidero = AccesoBench::generarVecino(algo, soluciones[i % p]).profit;
+            }));
+            mediciones.push_back(medir("Instancia::getDistancia", op, ciclos, [&](long long i) {
+                const auto& par = pares[i % pares.size()];
+                sumidero = inst.getDistancia(par.first, par.second);
+            }));
+            Instancia copia = inst;
+            mediciones.push_back(medir("Instancia::calcularMatrizDistancias", op, ciclos, [&](long long) {
+                AccesoBench::calcularMatrizDistancias(copia);
+                sumidero = copia.distancias.back().back();
+            }));
+
+            for (const Medicion& m : mediciones) {
+                json << (primero ? "\n" : ",\n");
+                primero = false;
+                json << "    {\"instancia\": \"" << escaparJSON(nombre) << "\", \"granjas\": " << inst.granjas.size()
+                     << ", \"nucleo\": \"" << m.nucleo << "\", \"lote\": " << m.lote
+                     << ", \"mediana_ns\": " << m.medianaNs << ", \"mad_ns\": " << m.madNs << ", \"min_ns\": " << m.minNs
+                     << ", \"mediana_ciclos\": ";
+                if (m.medianaCiclos >= 0.0) json << m.medianaCiclos;
+                else json << "null";
+                json << ", \"asignaciones\": " << m.asignacionesPorLlamada << ", \"bytes\": " << m.bytesPorLlamada << "}";
+            }
+            cerr << nombre << ": " << mediciones.size() << " nucleos medidos" << endl;
+        } catch (const exception& e) {
+            cerr << nombre << ": ERROR: " << e.what() << endl;
+        }
+    }
+    json << "\n  ]\n}\n";
+
+    if (pathSalida.empty()) {
+        cout << json.str();
+    } else {
+        ofstream salida(pathSalida);
+        if (!salida) {
+            cerr << "No se pudo escribir " << pathSalida << endl;
+            return 1;
+        }
+        salida << json.str();
+    }
+    return 0;
+}
@@ -0,0 +1,342 @@
+#include "checkpoint.h"
+#include <cstring>
+#include <cstdint>
+#include <sstream>
+#include <fstream>
+#include <filesystem>
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace fs = std::filesystem;
+
+// identifica el formato del archivo
+static const char MAGIA[8] = {'M', 'C', 'W', 'B', 'C', 'K', 'P', '2'};
+
+// --- serialización binaria (tipos nativos, el checkpoint se lee en la misma máquina) ---
+
+namespace {
+
+struct Escritura {
+    string datos;
+
+    template <typename T>
+    void valor(const T& v) { datos.append((const char*)&v, sizeof(T)); }
+
+    void texto(const string& s) {
+        valor<uint64_t>(s.size());
+        datos += s;
+    }
+
+    void lista(const vector<int>& l) {
+        valor<uint64_t>(l.size());
+        for (int v : l) valor<int32_t>(v);
+    }
+
+    void solucion(const Solucion& sol) {
+        valor<uint64_t>(sol.rutas.size());
+        for (const auto& ruta : sol.rutas) lista(ruta);
+        lista(sol.granjasNoVisitadas);
+    }
+
+    void registro(const RegistroConvergencia& r) {
+        valor(r.iteracion);
+        valor(r.profit);
+        valor(r.pesoCapacidad);
+        valor(r.pesoCuota);
+        valor(r.evento);
+    }
+};
+
+struct Lectura {
+    const string& datos;
+    size_t pos = 0;
+    bool ok = true;
+
+    explicit Lectura(const string& d) : datos(d) {}
+
+    template <typename T>
+    T valor() {
+        T v{};
+        if (pos + sizeof(T) > datos.size()) { ok = false; return v; }
+        memcpy(&v, datos.data() + pos, sizeof(T));
+        pos += sizeof(T);
+        return v;
+    }
+
+    // un bool se guarda como un byte; cualquier valor distinto de 0 o 1 indica corrupción
+    bool booleano() {
+        uint8_t v = valor<uint8_t>();
+        if (v > 1) ok = false;
+        return v == 1;
+    }
+
+    string texto() {
+        uint64_t n = valor<uint64_t>();
+        if (!ok || pos + n > datos.size()) { ok = false; return ""; }
+        string s = datos.substr(pos, n);
+        pos += n;
+        return s;
+    }
+
+    vector<int> lista() {
+        uint64_t n = valor<uint64_t>();
+        vector<int> l;
+        for (uint64_t i = 0; ok && i < n; ++i) l.push_back(valor<int32_t>());
+        return l;
+    }
+
+    Solucion solucion(const Instancia& inst) {
+        uint64_t numRutas = valor<uint64_t>();
+        if (!ok || numRutas != (uint64_t)inst.numCamiones) { ok = false; return Solucion(); }
+        vector<vector<int>> rutas(numRutas);
+        for (auto& ruta : rutas) ruta = lista();
+        vector<int> noVisitadas = lista();
+        if (!ok) return Solucion();
+
+        // los ids deben existir en la instancia antes de evaluar
+        for (const auto& ruta : rutas) {
+            for (int id : ruta) if (id < 2 || id > inst.numNodos) ok = false;
+        }
+        for (int id : noVisitadas) if (id < 2 || id > inst.numNodos) ok = false;
+        if (!ok) return Solucion();
+
+        // la evaluación es determinista, así que las métricas quedan idénticas
+        return Solucion(rutas, noVisitadas, inst);
+    }
+
+    RegistroConvergencia registro() {
+        RegistroConvergencia r;
+        r.iteracion = valor<long long>();
+        r.profit = valor<double>();
+        r.pesoCapacidad = valor<double>();
+        r.pesoCuota = valor<double>();
+        r.evento = valor<EventoSA>();
+        return r;
+    }
+};
+
+// escribe 'datos' en 'ruta' (truncando o agregando) y fuerza su llegada a disco
+bool escribirArchivo(const string& ruta, const string& datos, bool agregar) {
+    int flags = O_WRONLY | O_CREAT | (agregar ? O_APPEND : O_TRUNC);
+    int fd = open(ruta.c_str(), flags, 0644);
+    if (fd < 0) return false;
+
+    size_t escritos = 0;
+    while (escritos < datos.size()) {
+        ssize_t n = write(fd, datos.data() + escritos, datos.size() - escritos);
+        if (n <= 0) { close(fd); return false; }
+        escritos += n;
+    }
+    bool ok = fsync(fd) == 0;
+    return close(fd) == 0 && ok;
+}
+
+string leerArchivoBinario(const string& ruta) {
+    ifstream f(ruta, ios::binary);
+    stringstream buffer;
+    buffer << f.rdbuf();
+    return buffer.str();
+}
+
+const size_t TAMANO_REGISTRO = sizeof(long long) + 3 * sizeof(double) + sizeof(EventoSA);
+
+}
+
+// --- escritor en segundo plano ---
+
+EscritorCheckpoint::EscritorCheckpoint(const string& r) : ruta(r) {
+    hilo = thread(&EscritorCheckpoint::bucle, this);
+}
+
+EscritorCheckpoint::~EscritorCheckpoint() {
+    {
+        lock_guard<mutex> lock(mtx);
+        terminar = true;
+    }
+    cv.notify_one();
+    hilo.join();
+}
+
+void EscritorCheckpoint::encolar(Checkpoint&& ckpt) {
+    {
+        lock_guard<mutex> lock(mtx);
+        historialPendiente.insert(historialPendiente.end(), ckpt.historialNuevo.begin(), ckpt.historialNuevo.end());
+        ckpt.historialNuevo.clear();
+        pendiente = std::move(ckpt);
+        hayPendiente = true;
+    }
+    cv.notify_one();
+}
+
+void EscritorCheckpoint::bucle() {
+    while (true) {
+        Checkpoint ckpt;
+        vector<RegistroConvergencia> historial;
+        {
+            unique_lock<mutex> lock(mtx);
+            cv.wait(lock, [&] { return hayPendiente || terminar; });
+            if (!hayPendiente) return; // terminar sin nada pendiente
+            ckpt = std::move(pendiente);
+            historial.swap(historialPendiente);
+            hayPendiente = false;
+        }
+        if (!escribir(ckpt, historial)) {
+            // los registros no llegaron al disco: vuelven al frente de la cola para el próximo checkpoint
+            lock_guard<mutex> lock(mtx);
+            historialPendiente.insert(historialPendiente.begin(), historial.begin(), historial.end());
+        }
+    }
+}
+
+bool EscritorCheckpoint::escribir(const Checkpoint& ckpt, const vector<RegistroConvergencia>& historial) {
+    // 1. primero el historial, para que el cursor del checkpoint nunca apunte más allá
+    if (!historial.empty()) {
+        Escritura h;
+        for (const auto& r : historial) h.registro(r);
+        string pathHistorial = ruta + ".hist";
+        error_code ec;
+        uintmax_t tamanoPrevio = fs::exists(pathHistorial, ec) ? fs::file_size(pathHistorial, ec) : 0;
+        if (ec || !escribirArchivo(pathHistorial, h.datos, true)) {
+            // se descarta lo que haya quedado a medias para que el reintento no desalinee los registros
+            if (!ec) fs::resize_file(pathHistorial, tamanoPrevio, ec);
+            cerr << "Advertencia: no se pudo escribir el historial del checkpoint " << ruta << endl;
+            return false;
+        }
+    }
+
+    // 2. el estado completo, a un temporal que luego reemplaza al anterior
+    Escritura w;
+    w.datos.append(MAGIA, sizeof(MAGIA));
+    w.valor<int32_t>(ckpt.estado.solActual.rutas.size());
+    w.valor<int64_t>(ckpt.seed);
+
+    const EstadoSA& e = ckpt.estado;
+    w.solucion(e.solActual);
+    w.solucion(e.mejorSolucion);
+    w.valor(e.infActual.excesoCapacidad);
+    w.valor(e.infActual.deficitCuota);
+    w.valor(e.energiaActual);
+    w.valor(e.mejorEnergia);
+    w.valor(e.tempInicial);
+    w.valor(e.tempFinal);
+    w.valor(e.temperatura);
+    w.valor(e.tasaEnfriamiento);
+    w.valor(e.maxIteraciones);
+    w.valor(e.iteracion);
+    w.valor(e.factiblesCapacidad);
+    w.valor(e.factiblesCuota);
+    w.valor(e.iteracionesVentana);
+    w.valor(e.iteracionUltimaMejora);
+    w.valor<uint8_t>(e.mejoroDesdeUltimoEvento);
+    w.valor(e.deltaPromedio);
+    w.valor(e.segundosTranscurridos);
+
+    ostringstream rng;
+    rng << ckpt.rng;
+    w.texto(rng.str());
+
+    w.valor(ckpt.pesoCapacidad);
+    w.valor(ckpt.pesoCuota);
+    w.valor<uint64_t>(ckpt.elite.size());
+    for (const auto& sol : ckpt.elite) w.solucion(sol);
+    w.valor(ckpt.numRecalentamientos);
+    w.valor(ckpt.numReinicios);
+    w.valor(ckpt.tiempoPrimerFactible);
+    w.valor(ckpt.iteracionPrimerFactible);
+    w.valor<uint8_t>(ckpt.temperaturaCalibrada);
+    w.valor(ckpt.calibracion);
+    w.valor(ckpt.tasaCalibrada);
+    w.valor(ckpt.estadisticasReparacion.llamadas);
+    w.valor(ckpt.estadisticasReparacion.exitos);
+    w.valor(ckpt.estadisticasReparacion.busquedasCompletas);
+    w.valor(ckpt.estadisticasReparacion.segundos);
+    w.valor(ckpt.migrantesRecibidos);
+    w.valor(ckpt.migrantesAdoptados);
+    w.valor<uint64_t>(ckpt.cursorHistorial);
+
+    string temporal = ruta + ".tmp";
+    if (!escribirArchivo(temporal, w.datos, false) || rename(temporal.c_str(), ruta.c_str()) != 0) {
+        cerr << "Advertencia: no se pudo escribir el checkpoint " << ruta << endl;
+    }
+    return true;
+}
+
+// --- lectura ---
+
+bool EscritorCheckpoint::cargar(const string& ruta, const Instancia& inst, Checkpoint& ckpt) {
+    string datos = leerArchivoBinario(ruta);
+    if (datos.size() < sizeof(MAGIA) || memcmp(datos.data(), MAGIA, sizeof(MAGIA)) != 0) return false;
+
+    Lectura r(datos);
+    r.pos = sizeof(MAGIA);
+    if (r.valor<int32_t>() != inst.numCamiones) return false;
+    ckpt.seed = r.valor<int64_t>();
+
+    EstadoSA& e = ckpt.estado;
+    e.solActual = r.solucion(inst);
+    e.mejorSolucion = r.solucion(inst);
+    e.infActual.excesoCapacidad = r.valor<int>();
+    e.infActual.deficitCuota = r.valor<int>();
+    e.energiaActual = r.valor<double>();
+    e.mejorEnergia = r.valor<double>();
+    e.tempInicial = r.valor<double>();
+    e.tempFinal = r.valor<double>();
+    e.temperatura = r.valor<double>();
+    e.tasaEnfriamiento = r.valor<double>();
+    e.maxIteraciones = r.valor<long long>();
+    e.iteracion = r.valor<long long>();
+    e.factiblesCapacidad = r.valor<int>();
+    e.factiblesCuota = r.valor<int>();
+    e.iteracionesVentana = r.valor<int>();
+    e.iteracionUltimaMejora = r.valor<long long>();
+    e.mejoroDesdeUltimoEvento = r.booleano();
+    e.deltaPromedio = r.valor<double>();
+    e.segundosTranscurridos = r.valor<double>();
+
+    istringstream rng(r.texto());
+    rng >> ckpt.rng;
+    if (rng.fail()) return false;
+
+    ckpt.pesoCapacidad = r.valor<double>();
+    ckpt.pesoCuota = r.valor<double>();
+    uint64_t tamanoElite = r.valor<uint64_t>();
+    for (uint64_t i = 0; r.ok && i < tamanoElite; ++i) ckpt.elite.push_back(r.solucion(inst));
+    ckpt.numRecalentamientos = r.valor<int>();
+    ckpt.numReinicios = r.valor<int>();
+    ckpt.tiempoPrimerFactible = r.valor<double>();
+    ckpt.iteracionPrimerFactible = r.valor<long long>();
+    ckpt.temperaturaCalibrada = r.booleano();
+    ckpt.calibracion = r.valor<CalibracionTemperatura>();
+    ckpt.tasaCalibrada = r.valor<double>();
+    ckpt.estadisticasReparacion.llamadas = r.valor<long long>();
+    ckpt.estadisticasReparacion.exitos = r.valor<long long>();
+    ckpt.estadisticasReparacion.busquedasCompletas = r.valor<long long>();
+    ckpt.estadisticasReparacion.segundos = r.valor<double>();
+    ckpt.migrantesRecibidos = r.valor<int>();
+    ckpt.migrantesAdoptados = r.valor<int>();
+    ckpt.cursorHistorial = r.valor<uint64_t>();
+
+    return r.ok && r.pos == datos.size();
+}
+
+vector<RegistroConvergencia> EscritorCheckpoint::cargarHistorial(const string& ruta, size_t cursor) {
+    string pathHistorial = ruta + ".hist";
+    string datos = leerArchivoBinario(pathHistorial);
+
+    vector<RegistroConvergencia> historial;
+    Lectura r(datos);
+    while (historial.size() < cursor && r.pos + TAMANO_REGISTRO <= datos.size()) {
+        historial.push_back(r.registro());
+    }
+
+    // lo escrito después del checkpoint se volverá a generar al continuar
+    if (fs::exists(pathHistorial)) fs::resize_file(pathHistorial, historial.size() * TAMANO_REGISTRO);
+    return historial;
+}
+
+void EscritorCheckpoint::borrar(const string& ruta) {
+    error_code ec;
+    fs::remove(ruta, ec);
+    fs::remove(ruta + ".tmp", ec);
+    fs::remove(ruta + ".hist", ec);
+}
@@ -0,0 +1,73 @@
+#pragma once
+#include <string>
+#include <vector>
+#include <random>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include "algoritmo.h"
+
+using namespace std;
+
+// todo lo necesario para continuar una ejecución de SA de forma idéntica
+struct Checkpoint {
+    long seed = 0;
+    EstadoSA estado;
+    mt19937 rng;
+    double pesoCapacidad = 0.0;
+    double pesoCuota = 0.0;
+    vector<Solucion> elite;
+    int numRecalentamientos = 0;
+    int numReinicios = 0;
+    double tiempoPrimerFactible = -1.0;
+    long long iteracionPrimerFactible = -1;
+    bool temperaturaCalibrada = false;
+    CalibracionTemperatura calibracion{};
+    double tasaCalibrada = 0.0;
+    EstadisticasReparacion estadisticasReparacion;
+    int migrantesRecibidos = 0;
+    int migrantesAdoptados = 0;
+
+    // el historial se persiste de forma incremental en '<ruta>.hist': cada checkpoint trae
+    // solo los registros nuevos y el cursor indica cuántos registros son válidos en total
+    size_t cursorHistorial = 0;
+    vector<RegistroConvergencia> historialNuevo;
+};
+
+// escribe checkpoints en un hilo aparte para que el SA solo pague la copia del estado.
+// cada escritura va a '<ruta>.tmp' y luego se renombra, así el archivo siempre es válido.
+// si llegan checkpoints más rápido de lo que se escriben, solo se guarda el último
+// (pero ningún registro de historial se pierde).
+class EscritorCheckpoint {
+public:
+    explicit EscritorCheckpoint(const string& ruta);
+    ~EscritorCheckpoint(); // escribe lo pendiente y termina el hilo
+
+    EscritorCheckpoint(const EscritorCheckpoint&) = delete;
+    EscritorCheckpoint& operator=(const EscritorCheckpoint&) = delete;
+
+    void encolar(Checkpoint&& ckpt);
+
+    // lee un checkpoint; falla si el archivo está corrupto o es de otra instancia
+    static bool cargar(const string& ruta, const Instancia& inst, Checkpoint& ckpt);
+
+    // lee los primeros 'cursor' registros del historial y descarta los posteriores
+    static vector<RegistroConvergencia> cargarHistorial(const string& ruta, size_t cursor);
+
+    // elimina el checkpoint y su historial
+    static void borrar(const string& ruta);
+
+private:
+    void bucle();
+    // devuelve false si el historial no se pudo escribir (el estado tampoco se escribe)
+    bool escribir(const Checkpoint& ckpt, const vector<RegistroConvergencia>& historial);
+
+    string ruta;
+    mutex mtx;
+    condition_variable cv;
+    bool hayPendiente = false;
+    bool terminar = false;
+    Checkpoint pendiente;
+    vector<RegistroConvergencia> historialPendiente;
+    thread hilo;
+};
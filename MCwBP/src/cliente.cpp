@@ -0,0 +1,172 @@
+#include <iostream>
+#include <iomanip>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <map>
+#include <chrono>
+#include <algorithm>
+#include <cstring>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+
+using namespace std;
+using namespace std::chrono;
+
+// cliente de prueba del modo servicio: envía N solicitudes manteniendo K en vuelo y mide
+// la latencia de cada una (desde que se envía hasta que llega su respuesta completa).
+// uso: bin/cliente --socket ruta --instancia archivo [--solicitudes N] [--concurrencia K]
+//                  [--segundos S] [--por-ruta]
+
+static bool enviarTodo(int fd, const string& datos) {
+    size_t escritos = 0;
+    while (escritos < datos.size()) {
+        ssize_t n = write(fd, datos.data() + escritos, datos.size() - escritos);
+        if (n <= 0) return false;
+        escritos += n;
+    }
+    return true;
+}
+
+// lee una línea completa del socket (buffer compartido entre llamadas)
+static bool leerLinea(int fd, string& buffer, string& linea) {
+    while (true) {
+        size_t fin = buffer.find('\n');
+        if (fin != string::npos) {
+            linea = buffer.substr(0, fin);
+            buffer.erase(0, fin + 1);
+            return true;
+        }
+        char bloque[65536];
+        ssize_t n = read(fd, bloque, sizeof(bloque));
+        if (n <= 0) return false;
+        buffer.append(bloque, n);
+    }
+}
+
+static double percentil(vector<double> valores, double p) {
+    if (valores.empty()) return 0.0;
+    size_t k = min(valores.size() - 1, (size_t)(p * valores.size()));
+    nth_element(valores.begin(), valores.begin() + k, valores.end());
+    return valores[k];
+}
+
+int main(int argc, char* argv[]) {
+    string rutaSocket, pathInstancia;
+    int solicitudes = 200;
+    int concurrencia = 8;
+    double segundos = 0.2;
+    bool porRuta = false;
+
+    for (int i = 1; i < argc; ++i) {
+        string arg = argv[i];
+        if (arg == "--socket" && i + 1 < argc) rutaSocket = argv[++i];
+        else if (arg == "--instancia" && i + 1 < argc) pathInstancia = argv[++i];
+        else if (arg == "--solicitudes" && i + 1 < argc) solicitudes = stoi(argv[++i]);
+        else if (arg == "--concurrencia" && i + 1 < argc) concurrencia = stoi(argv[++i]);
+        else if (arg == "--segundos" && i + 1 < argc) segundos = stod(argv[++i]);
+        else if (arg == "--por-ruta") porRuta = true;
+        else {
+            cerr << "Uso: " << argv[0] << " --socket ruta --instancia archivo [--solicitudes N] [--concurrencia K]"
+                 << " [--segundos S] [--por-ruta]" << endl;
+            return 1;
+        }
+    }
+    if (rutaSocket.empty() || pathInstancia.empty()) {
+        cerr << "Se requieren --socket e --instancia." << endl;
+        return 1;
+    }
+
+    // la instancia va en línea (el servicio la reconoce por su contenido) o por ruta
+    string cuerpo;
+    if (!porRuta) {
+        ifstream archivo(pathInstancia);
+        if (!archivo) {
+            cerr << "No se pudo leer " << pathInstancia << endl;
+            return 1;
+        }
+        stringstream buffer;
+        buffer << archivo.rdbuf();
+        cuerpo = buffer.str();
+        if (!cuerpo.empty() && cuerpo.back() != '\n') cuerpo += '\n';
+        cuerpo += "fin\n";
+    }
+
+    int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    sockaddr_un dir{};
+    dir.sun_family = AF_UNIX;
+    strncpy(dir.sun_path, rutaSocket.c_str(), sizeof(dir.sun_path) - 1);
+    if (fd < 0 || connect(fd, (sockaddr*)&dir, sizeof(dir)) < 0) {
+        cerr << "No se pudo conectar a " << rutaSocket << endl;
+        return 1;
+    }
+
+    map<int, steady_clock::time_point> enVuelo;
+    vector<double> latenciasMs;
+    int enviadas = 0, errores = 0, factibles = 0;
+    string buffer, linea;
+
+    auto inicio = steady_clock::now();
+    while ((int)latenciasMs.size() < solicitudes) {
+        // mantener 'concurrencia' solicitudes en vuelo
+        while (enviadas < solicitudes && (int)enVuelo.size() < concurrencia) {
+            ostringstream cabecera;
+            cabecera << "resolver " << enviadas << " segundos=" << segundos;
+            if (porRuta) cabecera << " instancia=" << pathInstancia;
+            cabecera << "\n";
+            enVuelo[enviadas] = steady_clock::now();
+            if (!enviarTodo(fd, cabecera.str() + cuerpo)) {
+                cerr << "Conexión cerrada por el servicio." << endl;
+                return 1;
+            }
+            enviadas++;
+        }
+
+        if (!leerLinea(fd, buffer, linea)) {
+            cerr << "Conexión cerrada por el servicio." << endl;
+            return 1;
+        }
+        istringstream ss(linea);
+        string tipo;
+        int id;
+        if (!(ss >> tipo >> id) || (tipo != "ok" && tipo != "error")) continue;
+
+        if (tipo == "ok") {
+            if (linea.find("factible=1") != string::npos) factibles++;
+            while (leerLinea(fd, buffer, linea) && linea != "fin") {} // rutas
+        } else {
+            errores++;
+            if (errores <= 3) cerr << linea << endl;
+        }
+
+        auto it = enVuelo.find(id);
+        if (it == enVuelo.end()) continue;
+        latenciasMs.push_back(duration<double, milli>(steady_clock::now() - it->second).count());
+        enVuelo.erase(it);
+    }
+    double total = duration<double>(steady_clock::now() - inicio).count();
+
+    double promedio = 0.0;
+    for (double l : latenciasMs) promedio += l;
+    promedio /= max<size_t>(1, latenciasMs.size());
+
+    cout << "Solicitudes: " << latenciasMs.size() << " (errores: " << errores << ", factibles: " << factibles
+         << "), concurrencia: " << concurrencia << endl;
+    cout << fixed << setprecision(2);
+    cout << "Tiempo total: " << total << "s, throughput: " << latenciasMs.size() / total << " solicitudes/s" << endl;
+    cout << "Latencia (ms): promedio " << promedio << ", p50 " << percentil(latenciasMs, 0.5)
+         << ", p99 " << percentil(latenciasMs, 0.99) << ", max " << percentil(latenciasMs, 1.0) << endl;
+
+    // métricas vistas desde el servicio
+    enviarTodo(fd, "metricas\n");
+    while (leerLinea(fd, buffer, linea)) {
+        if (linea.rfind("metricas", 0) == 0) {
+            cout << "Servicio: " << linea.substr(9) << endl;
+            break;
+        }
+    }
+    close(fd);
+    return 0;
+}
@@ -0,0 +1,34 @@
+import json
+import sys
+
+# compara dos salidas de bin/bench (antes y después de un cambio), núcleo por núcleo.
+# un cambio se marca como significativo si la diferencia de medianas supera 3 veces la suma de
+# las MAD de ambas corridas.
+# uso: python3 src/comparar_bench.py antes.json despues.json
+
+if len(sys.argv) != 3:
+    print("Uso: python3 src/comparar_bench.py antes.json despues.json")
+    sys.exit(1)
+
+with open(sys.argv[1]) as f:
+    antes = json.load(f)
+with open(sys.argv[2]) as f:
+    despues = json.load(f)
+
+base = {(r["instancia"], r["nucleo"]): r for r in antes["resultados"]}
+
+print(f"{'Instancia':<14}{'Nucleo':<38}{'Antes (ns)':>12}{'Despues (ns)':>14}{'Cambio':>10}{'Asig.':>14}")
+significativos = 0
+for r in despues["resultados"]:
+    b = base.get((r["instancia"], r["nucleo"]))
+    if b is None:
+        continue
+    cambio = (r["mediana_ns"] - b["mediana_ns"]) / b["mediana_ns"] * 100.0
+    marca = ""
+    if abs(r["mediana_ns"] - b["mediana_ns"]) > 3.0 * (r["mad_ns"] + b["mad_ns"]):
+        marca = " *"
+        significativos += 1
+    asig = f"{b['asignaciones']:.1f}->{r['asignaciones']:.1f}"
+    print(f"{r['instancia']:<14}{r['nucleo']:<38}{b['mediana_ns']:>12.1f}{r['mediana_ns']:>14.1f}{cambio:>9.1f}%{asig:>14}{marca}")
+
+print(f"\n{significativos} cambio(s) significativo(s) (*: |dif. de medianas| > 3 * (MAD antes + MAD despues))")
@@ -0,0 +1,131 @@
+#include "cota.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+// ingresos con la leche en su mejor mezcla. con precios no crecientes en el orden de calidad,
+// la leche solo puede terminar en su tipo o en uno peor (blending), y conviene que cada prefijo
+// de tipos buenos conserve toda la leche posible. el máximo de cada prefijo queda limitado por la
+// leche de esos tipos y por lo que deben recibir los tipos peores para cumplir sus cuotas.
+static double ingresoMaximo(const Instancia& inst, bool& cuotasAlcanzables) {
+    int t = inst.numTiposLeche;
+    vector<double> oferta(t, 0.0);
+    for (const Nodo& granja : inst.granjas) oferta[inst.tipoLecheToIndex.at(granja.tipoLeche)] += granja.cantidadLeche;
+
+    bool precioNoCreciente = true;
+    for (int i = 1; i < t; ++i) precioNoCreciente &= inst.ingresosLeche[i] <= inst.ingresosLeche[i - 1];
+
+    cuotasAlcanzables = true;
+    if (!precioNoCreciente) {
+        // sin orden en los precios: cada unidad al mejor precio de los tipos que puede alcanzar
+        double ingreso = 0.0;
+        for (int i = 0; i < t; ++i) {
+            ingreso += oferta[i] * *max_element(inst.ingresosLeche.begin() + i, inst.ingresosLeche.end());
+        }
+        return ingreso;
+    }
+
+    // prefijo[i]: leche que termina en los tipos 0..i (el mayor posible)
+    vector<double> ofertaAcumulada(t, 0.0);
+    double acumulado = 0.0;
+    for (int i = 0; i < t; ++i) {
+        acumulado += oferta[i];
+        ofertaAcumulada[i] = acumulado;
+    }
+    vector<double> prefijo = ofertaAcumulada;
+    for (int i = t - 2; i >= 0; --i) prefijo[i] = min(prefijo[i], prefijo[i + 1] - inst.cuotasLeche[i + 1]);
+
+    // cuotas imposibles: no hay solución factible y la cota queda sin ellas
+    if (prefijo[0] < inst.cuotasLeche[0]) {
+        cuotasAlcanzables = false;
+        prefijo = ofertaAcumulada;
+    }
+
+    double ingreso = 0.0, anterior = 0.0;
+    for (int i = 0; i < t; ++i) {
+        ingreso += (prefijo[i] - anterior) * inst.ingresosLeche[i];
+        anterior = prefijo[i];
+    }
+    return ingreso;
+}
+
+// árbol de expansión mínima sobre la planta y todas las granjas (Prim, O(n²))
+static double costoArbol(const Instancia& inst) {
+    vector<int> ids{inst.planta.id};
+    for (const Nodo& granja : inst.granjas) ids.push_back(granja.id);
+
+    size_t n = ids.size();
+    vector<double> distancia(n, numeric_limits<double>::max());
+    vector<bool> enArbol(n, false);
+    distancia[0] = 0.0;
+    double total = 0.0;
+    for (size_t paso = 0; paso < n; ++paso) {
+        size_t u = n;
+        for (size_t v = 0; v < n; ++v) {
+            if (!enArbol[v] && (u == n || distancia[v] < distancia[u])) u = v;
+        }
+        enArbol[u] = true;
+        total += distancia[u];
+        for (size_t v = 0; v < n; ++v) {
+            if (!enArbol[v]) distancia[v] = min(distancia[v], inst.getDistancia(ids[u], ids[v]));
+        }
+    }
+    return total;
+}
+
+// cota por grados: cada arista se cuenta desde sus dos extremos. una granja usa dos aristas (dos
+// veces la de la planta si va sola en su ruta) y la planta dos por cada ruta, con al menos las
+// rutas necesarias para cargar toda la leche con los camiones más grandes
+static double costoGrados(const Instancia& inst) {
+    const int planta = inst.planta.id;
+    double suma = 0.0;
+    vector<double> aPlanta;
+
+    for (const Nodo& granja : inst.granjas) {
+        double primera = numeric_limits<double>::max(), segunda = numeric_limits<double>::max();
+        for (const Nodo& otra : inst.granjas) {
+            if (otra.id == granja.id) continue;
+            double d = inst.getDistancia(granja.id, otra.id);
+            if (d < primera) {
+                segunda = primera;
+                primera = d;
+            } else if (d < segunda) {
+                segunda = d;
+            }
+        }
+        double p = inst.getDistancia(planta, granja.id);
+        aPlanta.push_back(p);
+
+        double mejor = 2 * p;
+        if (primera < numeric_limits<double>::max()) mejor = min(mejor, p + primera);
+        if (segunda < numeric_limits<double>::max()) mejor = min(mejor, primera + segunda);
+        suma += mejor;
+    }
+
+    vector<int> capacidades = inst.capacidadesCamiones;
+    sort(capacidades.rbegin(), capacidades.rend());
+    long long leche = 0;
+    for (const Nodo& granja : inst.granjas) leche += granja.cantidadLeche;
+    size_t rutas = 0;
+    for (long long cargado = 0; cargado < leche && rutas < capacidades.size(); ++rutas) cargado += capacidades[rutas];
+
+    // las 2 * rutas aristas más baratas de la planta (cada granja aporta hasta dos)
+    sort(aPlanta.begin(), aPlanta.end());
+    for (size_t i = 0; i < 2 * rutas && i / 2 < aPlanta.size(); ++i) suma += aPlanta[i / 2];
+
+    return suma / 2.0;
+}
+
+CotaSuperior calcularCotaSuperior(const Instancia& inst) {
+    CotaSuperior cota;
+    cota.ingresoMaximo = ingresoMaximo(inst, cota.cuotasAlcanzables);
+    cota.costoArbol = costoArbol(inst);
+    cota.costoGrados = costoGrados(inst);
+    cota.costoMinimo = max(cota.costoArbol, cota.costoGrados);
+    cota.profit = cota.ingresoMaximo - cota.costoMinimo;
+    return cota;
+}
+
+double brechaOptimalidad(double profit, const CotaSuperior& cota) {
+    return (cota.profit - profit) / max(fabs(cota.profit), 1e-9);
+}
@@ -0,0 +1,27 @@
+#pragma once
+#include "instancia.h"
+
+using namespace std;
+
+// cota superior del profit de cualquier solución factible (todas las granjas visitadas, cuotas
+// cumplidas). solo depende de la instancia, así que se calcula una vez por instancia.
+struct CotaSuperior {
+    // ingresos: la leche de cada granja se vende en su mejor mezcla alcanzable. si los precios
+    // bajan con la calidad, se resta lo mínimo que cuesta degradar leche buena para cumplir cuotas.
+    double ingresoMaximo = 0.0;
+    bool cuotasAlcanzables = true;  // false: ni degradando toda la leche se cumplen las cuotas
+
+    // transporte: las rutas unidas conectan todos los nodos, así que cuestan al menos el árbol
+    // de expansión mínima; y cada granja tiene grado 2 (la planta, 2 por ruta), así que cuestan
+    // al menos la mitad de la suma de las aristas incidentes más baratas de cada nodo
+    double costoArbol = 0.0;
+    double costoGrados = 0.0;
+    double costoMinimo = 0.0;       // el mayor de los dos
+
+    double profit = 0.0;            // ingresoMaximo - costoMinimo
+};
+
+CotaSuperior calcularCotaSuperior(const Instancia& inst);
+
+// brecha relativa de 'profit' respecto de la cota: (cota - profit) / |cota|
+double brechaOptimalidad(double profit, const CotaSuperior& cota);
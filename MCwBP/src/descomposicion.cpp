@@ -0,0 +1,500 @@
+#include "descomposicion.h"
+#include "indice_espacial.h"
+#include "pool_hilos.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <exception>
+#include <limits>
+#include <numeric>
+#include <stdexcept>
+
+static double segundosDesde(chrono::steady_clock::time_point inicio) {
+    return chrono::duration<double>(chrono::steady_clock::now() - inicio).count();
+}
+
+// costo de poner una granja de tipo 'tipo' en un cluster que debe entregar leche 'objetivo':
+// una granja peor degrada todo el camión, una mejor solo su propia leche
+static double penalizacionCalidad(char tipo, char objetivo) {
+    if (tipo > objetivo) return 2.0 * (tipo - objetivo);
+    return (double)(objetivo - tipo);
+}
+
+// --- 1. grupos de camiones y clusters de granjas ---
+
+// reparte los camiones en grupos de 'porGrupo' en serpentina (de mayor a menor capacidad),
+// para que las capacidades de los grupos queden parecidas
+static vector<vector<int>> agruparCamiones(const Instancia& inst, int porGrupo) {
+    vector<int> camiones(inst.numCamiones);
+    iota(camiones.begin(), camiones.end(), 0);
+    stable_sort(camiones.begin(), camiones.end(), [&](int a, int b) {
+        return inst.capacidadesCamiones[a] > inst.capacidadesCamiones[b];
+    });
+
+    int k = (inst.numCamiones + porGrupo - 1) / porGrupo;
+    vector<vector<int>> grupos(k);
+    for (int i = 0; i < inst.numCamiones; ++i) {
+        int vuelta = i / k, pos = i % k;
+        grupos[vuelta % 2 == 0 ? pos : k - 1 - pos].push_back(camiones[i]);
+    }
+    return grupos;
+}
+
+// coordinación global de cuotas: el tipo de leche que entrega cada cluster. de la mejor calidad a
+// la peor, cada cuota se cubre con grupos (el más chico que la completa o, si ninguno alcanza,
+// el más grande). los grupos que sobran van a los tipos con más leche que las cuotas no absorben.
+static vector<char> planificarCalidades(const Instancia& inst, const vector<double>& capacidades) {
+    int k = capacidades.size(), t = inst.numTiposLeche;
+    vector<char> objetivo(k, 0);
+    vector<double> sobrante(t, 0.0);
+    for (const Nodo& granja : inst.granjas) sobrante[inst.tipoLecheToIndex.at(granja.tipoLeche)] += granja.cantidadLeche;
+
+    auto libres = [&] {
+        vector<int> g;
+        for (int i = 0; i < k; ++i) if (!objetivo[i]) g.push_back(i);
+        return g;
+    };
+
+    for (int tipo = 0; tipo < t; ++tipo) {
+        double falta = inst.cuotasLeche[tipo];
+        while (falta > 0) {
+            vector<int> g = libres();
+            if (g.empty()) break;
+            int elegido = -1;
+            for (int i : g) {
+                bool completa = capacidades[i] >= falta;
+                if (elegido == -1) { elegido = i; continue; }
+                bool completaElegido = capacidades[elegido] >= falta;
+                if (completa && (!completaElegido || capacidades[i] < capacidades[elegido])) elegido = i;
+                else if (!completa && !completaElegido && capacidades[i] > capacidades[elegido]) elegido = i;
+            }
+            objetivo[elegido] = 'A' + tipo;
+            falta -= capacidades[elegido];
+            sobrante[tipo] -= capacidades[elegido];
+        }
+    }
+
+    for (int i : libres()) {
+        int tipo = max_element(sobrante.begin(), sobrante.end()) - sobrante.begin();
+        objetivo[i] = 'A' + tipo;
+        sobrante[tipo] -= capacidades[i];
+    }
+    return objetivo;
+}
+
+// cluster de cada granja (indexado por id). parte de un barrido angular alrededor de la planta
+// cortado según la capacidad de cada grupo y luego re-asigna, por arrepentimiento decreciente,
+// cada granja al cluster más barato con espacio (distancia al centroide + penalización por no
+// coincidir con el tipo que entrega el cluster)
+static vector<int> agruparGranjas(const Instancia& inst, const vector<double>& capacidades,
+                                  const vector<char>& objetivo, const ParametrosDescomposicion& params) {
+    int k = capacidades.size();
+    vector<int> cluster(inst.numNodos + 1, -1);
+    if (inst.granjas.empty()) return cluster;
+
+    double escala = 0.0, lecheTotal = 0.0, capacidadTotal = 0.0;
+    for (const Nodo& granja : inst.granjas) {
+        escala += calcularDistancia(inst.planta, granja);
+        lecheTotal += granja.cantidadLeche;
+    }
+    escala = max(escala / inst.granjas.size(), 1e-9);
+    for (double c : capacidades) capacidadTotal += c;
+
+    // barrido: empieza en el mayor hueco angular para no partir un grupo natural de granjas
+    vector<pair<double, int>> angulos;
+    for (const Nodo& granja : inst.granjas) {
+        angulos.push_back({atan2(granja.y - inst.planta.y, granja.x - inst.planta.x), granja.id});
+    }
+    sort(angulos.begin(), angulos.end());
+    size_t inicio = 0;
+    double mayorHueco = -1.0;
+    for (size_t i = 0; i < angulos.size(); ++i) {
+        double previo = i == 0 ? angulos.back().first - 2 * M_PI : angulos[i - 1].first;
+        if (angulos[i].first - previo > mayorHueco) {
+            mayorHueco = angulos[i].first - previo;
+            inicio = i;
+        }
+    }
+    rotate(angulos.begin(), angulos.begin() + inicio, angulos.end());
+
+    double acumulado = 0.0, corte = 0.0;
+    int c = 0;
+    for (const auto& [angulo, id] : angulos) {
+        if (c < k - 1 && acumulado >= corte + lecheTotal * capacidades[c] / capacidadTotal) {
+            corte += lecheTotal * capacidades[c] / capacidadTotal;
+            c++;
+        }
+        cluster[id] = c;
+        acumulado += inst.getNodo(id).cantidadLeche;
+    }
+
+    // re-asignaciones
+    vector<double> cx(k, inst.planta.x), cy(k, inst.planta.y);
+    for (int it = 0; it < params.iteracionesAgrupamiento; ++it) {
+        vector<double> sx(k, 0.0), sy(k, 0.0), peso(k, 0.0);
+        for (const Nodo& granja : inst.granjas) {
+            int g = cluster[granja.id];
+            double w = max(granja.cantidadLeche, 1);
+            sx[g] += w * granja.x;
+            sy[g] += w * granja.y;
+            peso[g] += w;
+        }
+        for (int g = 0; g < k; ++g) {
+            if (peso[g] == 0.0) continue; // cluster vacío: conserva el centroide anterior
+            cx[g] = sx[g] / peso[g];
+            cy[g] = sy[g] / peso[g];
+        }
+
+        auto costo = [&](const Nodo& granja, int g) {
+            return hypot(granja.x - cx[g], granja.y - cy[g]) / escala
+                 + params.pesoCalidad * penalizacionCalidad(granja.tipoLeche, objetivo[g]);
+        };
+
+        // arrepentimiento: cuánto se pierde si la granja no va a su mejor cluster
+        vector<pair<double, int>> orden;
+        for (const Nodo& granja : inst.granjas) {
+            double mejor = numeric_limits<double>::max(), segundo = numeric_limits<double>::max();
+            for (int g = 0; g < k; ++g) {
+                double v = costo(granja, g);
+                if (v < mejor) {
+                    segundo = mejor;
+                    mejor = v;
+                } else if (v < segundo) {
+                    segundo = v;
+                }
+            }
+            orden.push_back({k > 1 ? segundo - mejor : 0.0, granja.id});
+        }
+        sort(orden.rbegin(), orden.rend());
+
+        vector<double> carga(k, 0.0);
+        bool cambio = false;
+        for (const auto& [arrepentimiento, id] : orden) {
+            const Nodo& granja = inst.getNodo(id);
+            int elegido = -1;
+            for (int g = 0; g < k; ++g) {
+                if (carga[g] + granja.cantidadLeche > capacidades[g]) continue;
+                if (elegido == -1 || costo(granja, g) < costo(granja, elegido)) elegido = g;
+            }
+            // no cabe en ninguno: al de más espacio libre (el SA o la frontera decidirán)
+            if (elegido == -1) {
+                elegido = 0;
+                for (int g = 1; g < k; ++g) {
+                    if (capacidades[g] - carga[g] > capacidades[elegido] - carga[elegido]) elegido = g;
+                }
+            }
+            carga[elegido] += granja.cantidadLeche;
+            cambio |= cluster[id] != elegido;
+            cluster[id] = elegido;
+        }
+        if (!cambio) break;
+    }
+    return cluster;
+}
+
+// --- 2. cuotas por cluster ---
+
+// cada cuota global se reparte entre los clusters que entregan ese tipo, según la leche que
+// pueden entregar (de ese tipo o mejor, hasta su capacidad). si ninguno lo entrega, según la leche
+// de ese tipo de cada cluster. el resto del redondeo va al cluster con más peso, así las cuotas de
+// los clusters suman exactamente la global.
+static vector<vector<int>> repartirCuotas(const Instancia& inst, const vector<int>& cluster,
+                                          const vector<double>& capacidades, const vector<char>& objetivo) {
+    int k = capacidades.size(), t = inst.numTiposLeche;
+    vector<vector<double>> leche(k, vector<double>(t, 0.0));
+    for (const Nodo& granja : inst.granjas) leche[cluster[granja.id]][inst.tipoLecheToIndex.at(granja.tipoLeche)] += granja.cantidadLeche;
+
+    vector<vector<int>> cuotas(k, vector<int>(t, 0));
+    for (int tipo = 0; tipo < t; ++tipo) {
+        vector<double> peso(k, 0.0);
+        for (int g = 0; g < k; ++g) {
+            if (objetivo[g] == 'A' + tipo) {
+                peso[g] = min(capacidades[g], accumulate(leche[g].begin(), leche[g].begin() + tipo + 1, 0.0));
+            }
+        }
+        if (accumulate(peso.begin(), peso.end(), 0.0) == 0.0) {
+            for (int g = 0; g < k; ++g) peso[g] = leche[g][tipo];
+        }
+        double total = accumulate(peso.begin(), peso.end(), 0.0);
+        if (total == 0.0) continue;
+
+        int asignado = 0;
+        for (int g = 0; g < k; ++g) {
+            cuotas[g][tipo] = (int)floor(inst.cuotasLeche[tipo] * peso[g] / total);
+            asignado += cuotas[g][tipo];
+        }
+        int mayor = max_element(peso.begin(), peso.end()) - peso.begin();
+        cuotas[mayor][tipo] += inst.cuotasLeche[tipo] - asignado;
+    }
+    return cuotas;
+}
+
+// --- 4. refinamiento de frontera ---
+
+struct MetricaRuta {
+    double costo = 0.0;
+    int carga = 0;
+    char calidad = 'A';
+};
+
+static MetricaRuta medirRuta(const Instancia& inst, const vector<int>& ruta) {
+    MetricaRuta m;
+    int previo = inst.planta.id;
+    for (int id : ruta) {
+        const Nodo& granja = inst.getNodo(id);
+        m.costo += inst.getDistancia(previo, id);
+        m.carga += granja.cantidadLeche;
+        m.calidad = max(m.calidad, granja.tipoLeche);
+        previo = id;
+    }
+    if (!ruta.empty()) m.costo += inst.getDistancia(previo, inst.planta.id);
+    return m;
+}
+
+// mueve granjas de la frontera (con algún vecino cercano en otro cluster) a la mejor posición
+// junto a ese vecino, o las intercambia con él, si la solución global mejora: primero baja la
+// infactibilidad (exceso de capacidad + déficit de las cuotas globales + leche sin visitar), a
+// igual infactibilidad sube el profit. las granjas sin visitar pueden ir a cualquier cluster
+// vecino. devuelve los movimientos aplicados.
+static int refinarFrontera(const Instancia& inst, vector<vector<int>>& rutas, vector<int>& noVisitadas,
+                           vector<int>& cluster, const vector<int>& clusterCamion,
+                           const ParametrosDescomposicion& params, int& pasadas) {
+    const int t = inst.numTiposLeche;
+    const int m = rutas.size();
+
+    // vecinos de cada granja (fijos: solo dependen de las coordenadas)
+    IndiceEspacial indice(inst);
+    vector<vector<int>> vecinos(inst.numNodos + 1);
+    for (const Nodo& granja : inst.granjas) indice.vecinos(granja.x, granja.y, params.vecinosFrontera, granja.id, vecinos[granja.id]);
+
+    vector<MetricaRuta> metricas(m);
+    vector<double> volumen(t, 0.0);
+    vector<int> camion(inst.numNodos + 1, -1), posicion(inst.numNodos + 1, -1);
+    auto indexar = [&](int k) {
+        for (size_t p = 0; p < rutas[k].size(); ++p) {
+            camion[rutas[k][p]] = k;
+            posicion[rutas[k][p]] = p;
+        }
+    };
+    for (int k = 0; k < m; ++k) {
+        metricas[k] = medirRuta(inst, rutas[k]);
+        if (!rutas[k].empty()) volumen[inst.tipoLecheToIndex.at(metricas[k].calidad)] += metricas[k].carga;
+        indexar(k);
+    }
+
+    auto ingreso = [&](const MetricaRuta& r) { return r.carga * inst.ingresosPorTipo.at(r.calidad) - r.costo; };
+    auto exceso = [&](const MetricaRuta& r, int k) { return max(0, r.carga - inst.capacidadesCamiones[k]); };
+    auto deficit = [&](const vector<double>& v) {
+        double total = 0.0;
+        for (int i = 0; i < t; ++i) total += max(0.0, inst.cuotasLeche[i] - v[i]);
+        return total;
+    };
+    auto sumarVolumen = [&](vector<double>& v, const MetricaRuta& r, bool vacia, double signo) {
+        if (!vacia) v[inst.tipoLecheToIndex.at(r.calidad)] += signo * r.carga;
+    };
+
+    double lecheNoVisitada = 0.0;
+    for (int id : noVisitadas) lecheNoVisitada += inst.getNodo(id).cantidadLeche;
+
+    // un movimiento cambia la ruta del camión b y, si a >= 0, la del camión a (a < 0: la granja
+    // estaba sin visitar y se recupera su leche)
+    struct Movimiento {
+        int a = -1, b = -1;
+        vector<int> rutaA, rutaB;
+        MetricaRuta metricaA, metricaB;
+        double inf = 0.0, ganancia = 0.0;
+    };
+    auto evaluar = [&](Movimiento& mov, double infBase, double lecheRecuperada) {
+        mov.metricaB = medirRuta(inst, mov.rutaB);
+        vector<double> volumenNuevo = volumen;
+        sumarVolumen(volumenNuevo, metricas[mov.b], rutas[mov.b].empty(), -1.0);
+        sumarVolumen(volumenNuevo, mov.metricaB, mov.rutaB.empty(), 1.0);
+        mov.ganancia = ingreso(mov.metricaB) - ingreso(metricas[mov.b]);
+        mov.inf = infBase - exceso(metricas[mov.b], mov.b) + exceso(mov.metricaB, mov.b) - lecheRecuperada;
+        if (mov.a >= 0) {
+            mov.metricaA = medirRuta(inst, mov.rutaA);
+            sumarVolumen(volumenNuevo, metricas[mov.a], rutas[mov.a].empty(), -1.0);
+            sumarVolumen(volumenNuevo, mov.metricaA, mov.rutaA.empty(), 1.0);
+            mov.ganancia += ingreso(mov.metricaA) - ingreso(metricas[mov.a]);
+            mov.inf += exceso(mov.metricaA, mov.a) - exceso(metricas[mov.a], mov.a);
+        }
+        mov.inf += deficit(volumenNuevo) - deficit(volumen);
+    };
+    auto aplicar = [&](Movimiento& mov) {
+        for (int k : {mov.a, mov.b}) {
+            if (k < 0) continue;
+            sumarVolumen(volumen, metricas[k], rutas[k].empty(), -1.0);
+            rutas[k] = std::move(k == mov.a ? mov.rutaA : mov.rutaB);
+            metricas[k] = k == mov.a ? mov.metricaA : mov.metricaB;
+            sumarVolumen(volumen, metricas[k], rutas[k].empty(), 1.0);
+            indexar(k);
+            for (int id : rutas[k]) cluster[id] = clusterCamion[k];
+        }
+    };
+
+    int movidas = 0;
+    pasadas = 0;
+    for (int pasada = 0; pasada < params.pasadasFrontera; ++pasada) {
+        pasadas++;
+        int movidasPasada = 0;
+
+        for (const Nodo& granja : inst.granjas) {
+            const int f = granja.id;
+            const int a = camion[f];
+
+            double infBase = deficit(volumen) + lecheNoVisitada;
+            for (int k = 0; k < m; ++k) infBase += exceso(metricas[k], k);
+
+            vector<int> origen;
+            if (a >= 0) {
+                origen = rutas[a];
+                origen.erase(origen.begin() + posicion[f]);
+            }
+
+            Movimiento mejor, candidato;
+            mejor.inf = infBase;
+            auto considerar = [&] {
+                if (candidato.inf < mejor.inf - 1e-9 ||
+                    (candidato.inf < mejor.inf + 1e-9 && candidato.ganancia > mejor.ganancia + 1e-9)) {
+                    mejor = candidato;
+                }
+            };
+
+            for (int v : vecinos[f]) {
+                int b = camion[v];
+                if (b < 0 || b == a || (a >= 0 && clusterCamion[b] == cluster[f])) continue;
+
+                // reubicar f junto a v
+                for (int pos : {posicion[v], posicion[v] + 1}) {
+                    candidato.a = a;
+                    candidato.b = b;
+                    if (a >= 0) candidato.rutaA = origen;
+                    candidato.rutaB = rutas[b];
+                    candidato.rutaB.insert(candidato.rutaB.begin() + pos, f);
+                    evaluar(candidato, infBase, a >= 0 ? 0.0 : granja.cantidadLeche);
+                    considerar();
+                }
+
+                // intercambiar f y v: cada una toma la posición de la otra
+                if (a >= 0) {
+                    candidato.a = a;
+                    candidato.b = b;
+                    candidato.rutaA = rutas[a];
+                    candidato.rutaA[posicion[f]] = v;
+                    candidato.rutaB = rutas[b];
+                    candidato.rutaB[posicion[v]] = f;
+                    evaluar(candidato, infBase, 0.0);
+                    considerar();
+                }
+            }
+
+            if (mejor.b == -1) continue;
+
+            if (a < 0) {
+                noVisitadas.erase(find(noVisitadas.begin(), noVisitadas.end(), f));
+                lecheNoVisitada -= granja.cantidadLeche;
+            }
+            aplicar(mejor);
+            movidasPasada++;
+        }
+
+        movidas += movidasPasada;
+        if (movidasPasada == 0) break;
+    }
+    return movidas;
+}
+
+// --- resolución ---
+
+ResultadoDescomposicion resolverPorDescomposicion(const Instancia& inst, const ParametrosDescomposicion& params,
+                                                  long semilla) {
+    if (params.camionesPorCluster < 1) throw invalid_argument("Se requiere al menos un camión por cluster");
+    if (params.limiteSegundos < 0.0) throw invalid_argument("El límite de tiempo no puede ser negativo");
+
+    auto inicio = chrono::steady_clock::now();
+    ResultadoDescomposicion res;
+
+    // 1. clusters
+    vector<vector<int>> grupos = agruparCamiones(inst, params.camionesPorCluster);
+    int k = grupos.size();
+    vector<double> capacidades(k, 0.0);
+    vector<int> clusterCamion(inst.numCamiones);
+    for (int g = 0; g < k; ++g) {
+        for (int camion : grupos[g]) {
+            capacidades[g] += inst.capacidadesCamiones[camion];
+            clusterCamion[camion] = g;
+        }
+    }
+    vector<char> objetivo = planificarCalidades(inst, capacidades);
+    vector<int> cluster = agruparGranjas(inst, capacidades, objetivo, params);
+    vector<vector<int>> cuotas = repartirCuotas(inst, cluster, capacidades, objetivo);
+
+    res.numClusters = k;
+    res.granjasPorCluster.assign(k, 0);
+    for (const Nodo& granja : inst.granjas) res.granjasPorCluster[cluster[granja.id]]++;
+    res.segundosAgrupamiento = segundosDesde(inicio);
+
+    // 3. subproblemas en paralelo: cada uno es una Instancia en memoria con ids 2..n propios
+    auto inicioSub = chrono::steady_clock::now();
+    vector<vector<int>> rutas(inst.numCamiones);
+    vector<int> noVisitadas;
+    vector<Solucion> soluciones(k);
+    vector<vector<int>> idGlobal(k); // id local -> id global (índice 1: la planta)
+    vector<exception_ptr> errores(k);
+    {
+        PoolHilos pool(params.numHilos);
+        // el límite es de toda la fase: con más clusters que hilos, cada uno recibe su parte
+        int noVacios = count_if(res.granjasPorCluster.begin(), res.granjasPorCluster.end(), [](int n) { return n > 0; });
+        double limiteSubproblema = params.limiteSegundos * min(pool.numHilos(), max(noVacios, 1)) / max(noVacios, 1);
+        for (int g = 0; g < k; ++g) {
+            idGlobal[g] = {0, inst.planta.id};
+            vector<Nodo> granjas;
+            for (const Nodo& granja : inst.granjas) {
+                if (cluster[granja.id] != g) continue;
+                Nodo local = granja;
+                local.id = granjas.size() + 2;
+                granjas.push_back(local);
+                idGlobal[g].push_back(granja.id);
+            }
+            if (granjas.empty()) continue;
+
+            vector<int> capacidadesGrupo;
+            for (int camion : grupos[g]) capacidadesGrupo.push_back(inst.capacidadesCamiones[camion]);
+
+            pool.encolar([&, g, granjas = std::move(granjas), capacidadesGrupo = std::move(capacidadesGrupo)] {
+                try {
+                    Instancia sub(capacidadesGrupo, cuotas[g], inst.ingresosLeche, inst.planta, granjas);
+                    Algoritmo algo(sub, semilla + 7919L * g);
+                    algo.mostrarLog = false;
+                    algo.limiteSegundos = limiteSubproblema;
+                    soluciones[g] = algo.ejecutarSimulatedAnnealing(params.sa);
+                } catch (...) {
+                    errores[g] = current_exception();
+                }
+            });
+        }
+        pool.esperarTodas();
+    }
+    for (const exception_ptr& error : errores) {
+        if (error) rethrow_exception(error);
+    }
+
+    // unión: la ruta local r del cluster g es la del camión grupos[g][r]
+    for (int g = 0; g < k; ++g) {
+        const Solucion& sol = soluciones[g];
+        for (size_t r = 0; r < sol.rutas.size(); ++r) {
+            for (int id : sol.rutas[r]) rutas[grupos[g][r]].push_back(idGlobal[g][id]);
+        }
+        for (int id : sol.granjasNoVisitadas) noVisitadas.push_back(idGlobal[g][id]);
+    }
+    res.segundosSubproblemas = segundosDesde(inicioSub);
+
+    // 4. frontera
+    auto inicioFrontera = chrono::steady_clock::now();
+    res.movimientosFrontera = refinarFrontera(inst, rutas, noVisitadas, cluster, clusterCamion, params, res.pasadasFrontera);
+    res.segundosFrontera = segundosDesde(inicioFrontera);
+
+    res.solucion = Solucion(rutas, noVisitadas, inst);
+    res.segundos = segundosDesde(inicio);
+    return res;
+}
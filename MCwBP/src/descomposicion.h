@@ -0,0 +1,45 @@
+#pragma once
+#include <vector>
+#include "instancia.h"
+#include "solucion.h"
+#include "algoritmo.h"
+
+using namespace std;
+
+// parámetros del modo descomposición (cluster-first)
+struct ParametrosDescomposicion {
+    int camionesPorCluster = 1;        // camiones de cada grupo; un cluster por grupo
+    double pesoCalidad = 1.0;          // peso de mezclar calidades al agrupar (en distancias medias a la planta)
+    int iteracionesAgrupamiento = 10;  // re-asignaciones tras el barrido inicial
+    int vecinosFrontera = 8;           // vecinos más cercanos que definen la frontera entre clusters
+    int pasadasFrontera = 5;           // pasadas máximas del refinamiento de frontera
+    int numHilos = 0;                  // hilos para los subproblemas (0: uno por núcleo)
+    double limiteSegundos = 0.0;       // tiempo de pared de la fase de subproblemas (0: sin límite)
+    ParametrosSA sa;                   // SA de cada subproblema
+};
+
+struct ResultadoDescomposicion {
+    Solucion solucion;
+    int numClusters = 0;
+    vector<int> granjasPorCluster;
+    int movimientosFrontera = 0;       // reubicaciones e intercambios entre clusters al refinar
+    int pasadasFrontera = 0;
+
+    double segundosAgrupamiento = 0.0;
+    double segundosSubproblemas = 0.0;
+    double segundosFrontera = 0.0;
+    double segundos = 0.0;             // total
+};
+
+// resuelve por descomposición:
+//  1. reparte los camiones en grupos de capacidad parecida y agrupa las granjas en un cluster
+//     por grupo (barrido angular alrededor de la planta y re-asignaciones que respetan la
+//     capacidad del grupo y evitan mezclar calidades). cada cluster entrega un tipo de leche,
+//     elegido para que entre todos cubran las cuotas globales
+//  2. reparte cada cuota global entre los clusters que entregan ese tipo
+//  3. resuelve cada cluster como una Instancia en memoria (ids 2..n propios) con un SA, en paralelo
+//  4. une las rutas y reubica o intercambia granjas de la frontera entre clusters vecinos mientras
+//     mejore la solución global (primero la infactibilidad, cuotas globales incluidas, luego el profit)
+// lanza invalid_argument si los parámetros no tienen sentido.
+ResultadoDescomposicion resolverPorDescomposicion(const Instancia& inst, const ParametrosDescomposicion& params,
+                                                  long semilla);
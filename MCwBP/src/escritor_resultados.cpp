@@ -0,0 +1,142 @@
+#include "escritor_resultados.h"
+#include "reoptimizacion.h"
+#include "graficador.h"
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+#include <stdexcept>
+
+EscritorResultados::EscritorResultados(const string& dirResultados, const string& dirGraficos, size_t capacidad)
+    : dirResultados(dirResultados), dirGraficos(dirGraficos), capacidad(max<size_t>(capacidad, 1)) {
+    hilo = thread(&EscritorResultados::bucle, this);
+}
+
+EscritorResultados::~EscritorResultados() {
+    {
+        lock_guard<mutex> lock(mtx);
+        terminar = true;
+    }
+    hayTrabajo.notify_one();
+    hilo.join();
+}
+
+void EscritorResultados::encolar(ResultadoLote&& resultado) {
+    unique_lock<mutex> lock(mtx);
+    hayLugar.wait(lock, [this] { return cola.size() < capacidad; });
+    cola.push_back(std::move(resultado));
+    lock.unlock();
+    hayTrabajo.notify_one();
+}
+
+void EscritorResultados::esperar() {
+    unique_lock<mutex> lock(mtx);
+    sinTrabajo.wait(lock, [this] { return cola.empty() && !escribiendo; });
+}
+
+void EscritorResultados::bucle() {
+    unique_lock<mutex> lock(mtx);
+    while (true) {
+        hayTrabajo.wait(lock, [this] { return terminar || !cola.empty(); });
+        if (cola.empty()) return; // terminar, sin pendientes
+
+        ResultadoLote r = std::move(cola.front());
+        cola.pop_front();
+        escribiendo = true;
+        lock.unlock();
+        hayLugar.notify_one();
+
+        try {
+            escribir(r);
+        } catch (const exception& e) {
+            cerr << r.nombre << ": ERROR al escribir resultados: " << e.what() << endl;
+        }
+
+        lock.lock();
+        escribiendo = false;
+        if (cola.empty()) sinTrabajo.notify_all();
+    }
+}
+
+static void escribirArchivo(const string& ruta, const string& contenido) {
+    ofstream salida(ruta, ios::binary);
+    salida << contenido;
+    if (!salida) throw runtime_error("no se pudo escribir " + ruta);
+}
+
+void EscritorResultados::escribir(const ResultadoLote& r) {
+    const Instancia& instancia = *r.instancia;
+    const EstadisticasSolver& est = r.resultado.estadisticas;
+    const Solucion& solFinal = r.resultado.solucion;
+
+    // 1. archivo de resultados (el formato que lee bin/analisis)
+    ostringstream out;
+    out << "Instancia: " << r.nombre << endl;
+    out << "Nodos: " << instancia.numNodos << ", Camiones: " << instancia.numCamiones << endl;
+
+    out << "\n--- Solución Inicial (Greedy) ---" << endl;
+    out << "Profit: " << (long)est.profitInicial << endl;
+    out << "Factible: " << (est.factibleInicial ? "Si" : "No") << endl;
+
+    if (r.motor == MotorBusqueda::Genetico) {
+        out << "\n--- Ejecutando Genetico ---" << endl;
+        out << "Genetico terminado (" << est.generaciones << " generaciones, "
+            << est.iteraciones << " iteraciones de educacion)." << endl;
+    } else {
+        out << "\n--- Ejecutando SA ---" << endl;
+        out << "Simulated Annealing terminado (" << est.iteraciones << " iteraciones)." << endl;
+    }
+
+    if (est.temperaturaCalibrada) {
+        const CalibracionTemperatura& cal = est.calibracion;
+        out << "\n--- Calibracion de Temperatura ---" << endl;
+        out << "Muestras: " << cal.muestras << " (empeoramientos: " << cal.empeoramientos << ")" << endl;
+        out << "Delta alto: " << fixed << setprecision(2) << cal.deltaAlto
+            << ", Delta bajo: " << cal.deltaBajo << endl;
+        out << "Temperatura inicial: " << cal.tempInicial << ", final: " << cal.tempFinal
+            << ", tasa: " << setprecision(10) << est.tasaCalibrada << endl;
+    }
+
+    out << "\n--- Mejor Solución Final (" << (r.motor == MotorBusqueda::Genetico ? "Genetico" : "SA") << ") ---" << endl;
+    out << "Tiempo: " << fixed << setprecision(3) << r.segundos << "s" << endl;
+    solFinal.imprimirFormatoSalida(est.semilla, instancia, out);
+    out << "Factible: " << (solFinal.esFactible ? "Si" : "No") << endl;
+    if (est.iteracionPrimerFactible >= 0) {
+        out << "Primer factible: " << fixed << setprecision(3) << est.tiempoPrimerFactible
+            << "s (iteracion " << est.iteracionPrimerFactible << ")" << endl;
+    } else {
+        out << "Primer factible: -" << endl;
+    }
+    out << "Recalentamientos: " << est.recalentamientos << ", Reinicios: " << est.reinicios << endl;
+    if (r.motor == MotorBusqueda::SA) {
+        out << "Reparaciones: " << est.reparacion.exitos << "/" << est.reparacion.llamadas
+            << " (busquedas completas: " << est.reparacion.busquedasCompletas << ", "
+            << setprecision(2) << est.reparacion.microsegundosPorLlamada() << " us/llamada)" << endl;
+    }
+    out << "Cota superior: " << setprecision(0) << est.cota.profit << " (ingresos " << est.cota.ingresoMaximo
+        << ", transporte >= " << est.cota.costoMinimo << (est.cota.cuotasAlcanzables ? "" : ", cuotas inalcanzables")
+        << ")" << endl;
+    if (est.brecha >= 0.0) {
+        out << "Brecha: " << setprecision(3) << est.brecha * 100.0 << "%"
+            << (est.terminadaPorBrecha ? " (terminada por brecha)" : "") << endl;
+    } else {
+        out << "Brecha: -" << endl;
+    }
+    escribirArchivo(dirResultados + r.nombre, out.str());
+
+    // 2. plan estructurado para re-optimizar al día siguiente (--reoptimizar)
+    guardarPlan(dirResultados + r.nombre + ".plan", solFinal, instancia);
+
+    // 3. datos de convergencia y su gráfico
+    ostringstream csv;
+    csv << "Iteracion,Profit,PesoCapacidad,PesoCuota,Evento\n";
+    vector<Punto> puntos;
+    puntos.reserve(r.resultado.historial.size());
+    for (const auto& registro : r.resultado.historial) {
+        csv << registro.iteracion << "," << fixed << setprecision(2) << registro.profit << ","
+            << registro.pesoCapacidad << "," << registro.pesoCuota << "," << nombreEvento(registro.evento) << "\n";
+        puntos.push_back({(double)registro.iteracion, registro.profit});
+    }
+    escribirArchivo(dirResultados + r.nombre + ".csv", csv.str());
+
+    Graficador::generarSVG(puntos, dirGraficos + r.nombre + ".svg");
+}
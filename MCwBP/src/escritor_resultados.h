@@ -0,0 +1,54 @@
+#pragma once
+#include <string>
+#include <deque>
+#include <memory>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include "solver.h"
+
+using namespace std;
+
+// resultado de una instancia del modo lote, listo para escribir
+struct ResultadoLote {
+    string nombre;                          // nombre del archivo de la instancia
+    shared_ptr<const Instancia> instancia;
+    ResultadoSolver resultado;
+    MotorBusqueda motor = MotorBusqueda::SA;
+    double segundos = 0.0;                  // greedy + motor, medido por quien resolvió
+};
+
+// escribe los resultados del modo lote en un hilo aparte: archivo de texto, plan, CSV de
+// convergencia y SVG (desde el historial en memoria, sin releer el CSV). cada archivo se arma
+// en memoria y se escribe de una vez. la cola es acotada: si el disco no da abasto, encolar()
+// espera a que haya lugar en vez de acumular historiales sin límite.
+class EscritorResultados {
+public:
+    EscritorResultados(const string& dirResultados, const string& dirGraficos, size_t capacidad = 4);
+    ~EscritorResultados(); // escribe lo pendiente y termina el hilo
+
+    EscritorResultados(const EscritorResultados&) = delete;
+    EscritorResultados& operator=(const EscritorResultados&) = delete;
+
+    void encolar(ResultadoLote&& resultado);
+
+    // barrera: bloquea hasta que todo lo encolado está escrito
+    void esperar();
+
+private:
+    void bucle();
+    void escribir(const ResultadoLote& r);
+
+    string dirResultados;
+    string dirGraficos;
+    size_t capacidad;
+
+    mutex mtx;
+    condition_variable hayTrabajo;
+    condition_variable hayLugar;
+    condition_variable sinTrabajo;
+    deque<ResultadoLote> cola;
+    bool escribiendo = false;
+    bool terminar = false;
+    thread hilo;
+};
@@ -0,0 +1,378 @@
+#include "genetico.h"
+#include "pool_hilos.h"
+#include "progreso.h"
+#include "cota.h"
+#include <algorithm>
+#include <numeric>
+#include <limits>
+#include <chrono>
+#include <cmath>
+
+AlgoritmoGenetico::AlgoritmoGenetico(const Instancia& i, long s, const ParametrosGenetico& p)
+    : inst(i), seed(s), rng(s), params(p), evaluador(i, s) {
+    ordenCamiones.resize(inst.numCamiones);
+    iota(ordenCamiones.begin(), ordenCamiones.end(), 0);
+    stable_sort(ordenCamiones.begin(), ordenCamiones.end(), [&](int a, int b) {
+        return inst.capacidadesCamiones[a] > inst.capacidadesCamiones[b];
+    });
+}
+
+// --- representación ---
+
+vector<int> AlgoritmoGenetico::giantTour(const Solucion& sol) const {
+    vector<int> tour;
+    for (int k : ordenCamiones) tour.insert(tour.end(), sol.rutas[k].begin(), sol.rutas[k].end());
+    tour.insert(tour.end(), sol.granjasNoVisitadas.begin(), sol.granjasNoVisitadas.end());
+    return tour;
+}
+
+Solucion AlgoritmoGenetico::split(const vector<int>& tour) const {
+    const int n = tour.size();
+    const int m = inst.numCamiones;
+    const int planta = inst.planta.id;
+
+    // mejor[k][i]: con los primeros k camiones (en ordenCamiones) y las primeras i granjas
+    // del tour. se minimizan primero las granjas saltadas y luego se maximiza el valor
+    // (ingreso según la calidad más baja de cada ruta menos la distancia).
+    struct Etiqueta {
+        int saltadas = numeric_limits<int>::max();
+        double valor = 0.0;
+        int desde = -1;      // índice del tour donde empieza el segmento (o -1)
+        char tipo = 0;       // 's': granja saltada, 'v': camión sin ruta, 'r': ruta [desde, i)
+    };
+    auto mejora = [](const Etiqueta& nueva, const Etiqueta& actual) {
+        if (nueva.saltadas != actual.saltadas) return nueva.saltadas < actual.saltadas;
+        return nueva.valor > actual.valor;
+    };
+
+    vector<vector<Etiqueta>> mejor(m + 1, vector<Etiqueta>(n + 1));
+    mejor[0][0].saltadas = 0;
+
+    for (int k = 0; k <= m; ++k) {
+        for (int i = 0; i <= n; ++i) {
+            const Etiqueta& e = mejor[k][i];
+            if (e.saltadas == numeric_limits<int>::max()) continue;
+
+            // saltar la granja i (queda sin visitar)
+            if (i < n) {
+                Etiqueta s{e.saltadas + 1, e.valor, i, 's'};
+                if (mejora(s, mejor[k][i + 1])) mejor[k][i + 1] = s;
+            }
+            if (k == m) continue;
+
+            // el camión k no sale
+            Etiqueta v{e.saltadas, e.valor, i, 'v'};
+            if (mejora(v, mejor[k + 1][i])) mejor[k + 1][i] = v;
+
+            // el camión k recoge el segmento [i, j]
+            int camion = ordenCamiones[k];
+            int carga = 0;
+            double distancia = 0.0;
+            char calidad = 'A';
+            int previo = planta;
+            for (int j = i; j < n; ++j) {
+                const Nodo& granja = inst.getNodo(tour[j]);
+                carga += granja.cantidadLeche;
+                if (carga > inst.capacidadesCamiones[camion]) break;
+                distancia += inst.getDistancia(previo, granja.id);
+                previo = granja.id;
+                if (granja.tipoLeche > calidad) calidad = granja.tipoLeche;
+
+                double valorRuta = carga * inst.ingresosPorTipo.at(calidad) - distancia - inst.getDistancia(previo, planta);
+                Etiqueta r{e.saltadas, e.valor + valorRuta, i, 'r'};
+                if (mejora(r, mejor[k + 1][j + 1])) mejor[k + 1][j + 1] = r;
+            }
+        }
+    }
+
+    // reconstruir desde mejor[m][n]
+    vector<vector<int>> rutas(m);
+    vector<int> noVisitadas;
+    int k = m, i = n;
+    while (k > 0 || i > 0) {
+        const Etiqueta& e = mejor[k][i];
+        if (e.tipo == 's') {
+            noVisitadas.push_back(tour[e.desde]);
+            i = e.desde;
+        } else if (e.tipo == 'v') {
+            k--;
+        } else {
+            rutas[ordenCamiones[k - 1]].assign(tour.begin() + e.desde, tour.begin() + i);
+            i = e.desde;
+            k--;
+        }
+    }
+    reverse(noVisitadas.begin(), noVisitadas.end());
+    return Solucion(rutas, noVisitadas, inst);
+}
+
+vector<int> AlgoritmoGenetico::cruceOX(const vector<int>& a, const vector<int>& b, mt19937& gen) const {
+    const int n = a.size();
+    if (n < 2 || b.size() != a.size()) return a;
+
+    int i = gen() % n;
+    int j = gen() % n;
+    if (i > j) swap(i, j);
+
+    vector<int> hijo(n);
+    vector<char> usado(inst.numNodos + 1, 0);
+    for (int p = i; p <= j; ++p) {
+        hijo[p] = a[p];
+        usado[a[p]] = 1;
+    }
+
+    // completar después del segmento, en el orden cíclico del segundo padre
+    int escribir = (j + 1) % n;
+    for (int q = 0; q < n; ++q) {
+        int id = b[(j + 1 + q) % n];
+        if (usado[id]) continue;
+        hijo[escribir] = id;
+        escribir = (escribir + 1) % n;
+    }
+    return hijo;
+}
+
+Solucion AlgoritmoGenetico::educar(const Solucion& sol, long semilla, double limite, long long& iteraciones) const {
+    Algoritmo algo(inst, semilla);
+    algo.mostrarLog = false;
+    algo.parametrosPenalizacion = parametrosPenalizacion;
+    algo.parametrosEstancamiento.activo = false; // la diversidad la maneja la población
+    algo.limiteSegundos = limite;
+    algo.cancelacion = cancelacion;
+    Solucion educada = algo.ejecutarSimulatedAnnealing(sol, tempEducacionInicial, tempEducacionFinal, tasaEducacion);
+    iteraciones = algo.iteracionesRealizadas;
+    return educada;
+}
+
+// --- población ---
+
+AlgoritmoGenetico::Individuo AlgoritmoGenetico::crearIndividuo(Solucion sol) const {
+    Individuo ind;
+    ind.inf = evaluador.medirInfactibilidad(sol);
+    ind.energia = sol.profit - ind.inf.excesoCapacidad * parametrosPenalizacion.pesoCapacidadInicial
+                             - ind.inf.deficitCuota * parametrosPenalizacion.pesoCuotaInicial;
+
+    for (const auto& ruta : sol.rutas) {
+        if (ruta.empty()) continue;
+        int previo = inst.planta.id;
+        for (int id : ruta) {
+            ind.aristas.push_back({min(previo, id), max(previo, id)});
+            previo = id;
+        }
+        ind.aristas.push_back({min(previo, inst.planta.id), max(previo, inst.planta.id)});
+    }
+    sort(ind.aristas.begin(), ind.aristas.end());
+    ind.sol = std::move(sol);
+    return ind;
+}
+
+// mismo orden que el SA: primero factibilidad, luego energía
+bool AlgoritmoGenetico::mejorQue(const Individuo& a, const Individuo& b) const {
+    if (a.sol.esFactible != b.sol.esFactible) return a.sol.esFactible;
+    return a.energia > b.energia;
+}
+
+// fracción de aristas que no comparten (broken pairs)
+double AlgoritmoGenetico::distancia(const Individuo& a, const Individuo& b) const {
+    size_t mayor = max(a.aristas.size(), b.aristas.size());
+    if (mayor == 0) return 0.0;
+    size_t comunes = 0;
+    auto ia = a.aristas.begin(), ib = b.aristas.begin();
+    while (ia != a.aristas.end() && ib != b.aristas.end()) {
+        if (*ia < *ib) ++ia;
+        else if (*ib < *ia) ++ib;
+        else { ++comunes; ++ia; ++ib; }
+    }
+    return 1.0 - (double)comunes / mayor;
+}
+
+// aptitud sesgada: rango por calidad + peso * rango por contribución a la diversidad
+void AlgoritmoGenetico::calcularAptitud() {
+    const int n = poblacion.size();
+    if (n <= 1) {
+        for (auto& ind : poblacion) ind.aptitud = 0.0;
+        return;
+    }
+
+    vector<int> porCalidad(n);
+    iota(porCalidad.begin(), porCalidad.end(), 0);
+    sort(porCalidad.begin(), porCalidad.end(), [&](int a, int b) { return mejorQue(poblacion[a], poblacion[b]); });
+
+    vector<double> diversidad(n, 0.0);
+    for (int i = 0; i < n; ++i) {
+        vector<double> distancias;
+        for (int j = 0; j < n; ++j) if (j != i) distancias.push_back(distancia(poblacion[i], poblacion[j]));
+        int vecinos = min((int)distancias.size(), max(1, params.vecinosDiversidad));
+        partial_sort(distancias.begin(), distancias.begin() + vecinos, distancias.end());
+        for (int v = 0; v < vecinos; ++v) diversidad[i] += distancias[v] / vecinos;
+    }
+    vector<int> porDiversidad(n);
+    iota(porDiversidad.begin(), porDiversidad.end(), 0);
+    sort(porDiversidad.begin(), porDiversidad.end(), [&](int a, int b) { return diversidad[a] > diversidad[b]; });
+
+    double pesoDiversidad = max(0.0, 1.0 - (double)params.elitesProtegidos / n);
+    for (int r = 0; r < n; ++r) {
+        poblacion[porCalidad[r]].aptitud = (double)r / (n - 1);
+    }
+    for (int r = 0; r < n; ++r) {
+        poblacion[porDiversidad[r]].aptitud += pesoDiversidad * r / (n - 1);
+    }
+}
+
+void AlgoritmoGenetico::seleccionarSobrevivientes(vector<Individuo>& hijos) {
+    for (auto& hijo : hijos) {
+        if (!hijo.sol.rutas.empty()) poblacion.push_back(std::move(hijo));
+    }
+
+    while ((int)poblacion.size() > params.tamanoPoblacion) {
+        calcularAptitud();
+
+        // primero los clones (el peor de cada par); si no hay, el de peor aptitud
+        int eliminar = -1;
+        for (size_t i = 0; i < poblacion.size(); ++i) {
+            for (size_t j = 0; j < poblacion.size(); ++j) {
+                if (i == j || !mejorQue(poblacion[j], poblacion[i])) continue;
+                if (distancia(poblacion[i], poblacion[j]) >= params.distanciaClon) continue;
+                if (eliminar < 0 || poblacion[i].aptitud > poblacion[eliminar].aptitud) eliminar = i;
+                break;
+            }
+        }
+        if (eliminar < 0) {
+            eliminar = max_element(poblacion.begin(), poblacion.end(), [](const Individuo& a, const Individuo& b) {
+                return a.aptitud < b.aptitud;
+            }) - poblacion.begin();
+        }
+        poblacion.erase(poblacion.begin() + eliminar);
+    }
+    calcularAptitud();
+}
+
+// --- bucle principal ---
+
+Solucion AlgoritmoGenetico::ejecutar() {
+    auto inicio = chrono::steady_clock::now();
+    auto segundos = [&] { return chrono::duration<double>(chrono::steady_clock::now() - inicio).count(); };
+
+    historialConvergencia.clear();
+    generaciones = 0;
+    iteracionesEducacion = 0;
+    tiempoPrimerFactible = -1.0;
+    iteracionPrimerFactible = -1;
+    cancelada = false;
+    terminadaPorBrecha = false;
+    poblacion.clear();
+
+    // temperaturas de la educación: un SA corto y frío, como en la re-optimización
+    evaluador.parametrosPenalizacion = parametrosPenalizacion;
+    Solucion greedy = evaluador.generarSolucionInicialGreedy();
+    CalibracionTemperatura cal = evaluador.calibrarTemperaturas(greedy, 1000, 0.1, 0.01, 0.5, 0.1);
+    tempEducacionInicial = cal.tempInicial;
+    tempEducacionFinal = cal.tempFinal;
+    tasaEducacion = pow(tempEducacionFinal / tempEducacionInicial, 1.0 / max(1LL, params.iteracionesEducacion));
+
+    PoolHilos pool(params.numHilos);
+    Individuo mejor = crearIndividuo(greedy);
+
+    auto registrar = [&](bool terminada) {
+        for (const auto& ind : poblacion) {
+            if (mejorQue(ind, mejor)) mejor = ind;
+        }
+        if (iteracionPrimerFactible < 0 && mejor.sol.esFactible) {
+            tiempoPrimerFactible = segundos();
+            iteracionPrimerFactible = iteracionesEducacion;
+        }
+        historialConvergencia.push_back({iteracionesEducacion, mejor.sol.profit, parametrosPenalizacion.pesoCapacidadInicial,
+                                         parametrosPenalizacion.pesoCuotaInicial, EventoSA::Ninguno});
+        if (progreso) progreso->publicar({iteracionesEducacion, 0, mejor.sol.profit, mejor.sol.esFactible, 0.0, terminada});
+    };
+
+    // cada hijo se educa en una tarea del pool. las semillas y los padres se eligen antes en
+    // este hilo, así el resultado no depende de la cantidad de hilos. cada educación recibe el
+    // tiempo que le queda a la ejecución y el token de cancelación; los hijos que no alcanzan a
+    // empezar se descartan y 'destino' queda solo con los educados.
+    auto educarEnParalelo = [&](vector<Individuo>& destino, const vector<vector<int>>& tours, const vector<long>& semillas) {
+        vector<Individuo> educados(tours.size());
+        vector<long long> iteraciones(tours.size(), -1); // -1: no se educó
+        for (size_t h = 0; h < tours.size(); ++h) {
+            pool.encolar([&, h] {
+                if (cancelacion && cancelacion->cancelado()) return;
+                double restante = limiteSegundos > 0.0 ? limiteSegundos - segundos() : 0.0;
+                if (limiteSegundos > 0.0 && restante <= 0.0) return;
+                educados[h] = crearIndividuo(educar(split(tours[h]), semillas[h], restante, iteraciones[h]));
+            });
+        }
+        pool.esperarTodas();
+
+        destino.clear();
+        for (size_t h = 0; h < tours.size(); ++h) {
+            if (iteraciones[h] < 0) continue;
+            destino.push_back(std::move(educados[h]));
+            iteracionesEducacion += iteraciones[h];
+        }
+        if (cancelacion && cancelacion->cancelado()) cancelada = true;
+    };
+
+    // 1. población inicial: el greedy y permutaciones aleatorias, todos educados
+    {
+        vector<vector<int>> tours;
+        vector<long> semillas;
+        vector<int> base = giantTour(greedy);
+        tours.push_back(base);
+        semillas.push_back(rng());
+        for (int p = 1; p < params.tamanoPoblacion; ++p) {
+            shuffle(base.begin(), base.end(), rng);
+            tours.push_back(base);
+            semillas.push_back(rng());
+        }
+        vector<Individuo> iniciales;
+        educarEnParalelo(iniciales, tours, semillas);
+        seleccionarSobrevivientes(iniciales);
+        registrar(false);
+    }
+
+    // 2. generaciones: torneo binario por aptitud, OX + split, educación y supervivencia
+    auto torneo = [&]() -> const Individuo& {
+        const Individuo& a = poblacion[rng() % poblacion.size()];
+        const Individuo& b = poblacion[rng() % poblacion.size()];
+        return a.aptitud <= b.aptitud ? a : b;
+    };
+
+    auto brechaAlcanzada = [&] {
+        return cotaSuperior && mejor.sol.esFactible && brechaOptimalidad(mejor.sol.profit, *cotaSuperior) <= epsilonBrecha;
+    };
+
+    double duracionGeneracion = 0.0;
+    while (generaciones < params.maxGeneraciones && !poblacion.empty()) {
+        if (brechaAlcanzada()) {
+            terminadaPorBrecha = true;
+            break;
+        }
+        // no empezar una generación que no alcanza a terminar dentro del límite
+        if (limiteSegundos > 0.0 && segundos() + duracionGeneracion > limiteSegundos) break;
+        if (cancelacion && cancelacion->cancelado()) {
+            cancelada = true;
+            break;
+        }
+
+        double inicioGeneracion = segundos();
+        vector<vector<int>> tours;
+        vector<long> semillas;
+        for (int h = 0; h < params.hijosPorGeneracion; ++h) {
+            const Individuo& padreA = torneo();
+            const Individuo& padreB = torneo();
+            mt19937 gen(rng());
+            tours.push_back(cruceOX(giantTour(padreA.sol), giantTour(padreB.sol), gen));
+            semillas.push_back(rng());
+        }
+
+        vector<Individuo> hijos;
+        educarEnParalelo(hijos, tours, semillas);
+        seleccionarSobrevivientes(hijos);
+        generaciones++;
+        registrar(false);
+        duracionGeneracion = segundos() - inicioGeneracion;
+    }
+
+    registrar(true);
+    return mejor.sol;
+}
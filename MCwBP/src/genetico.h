@@ -0,0 +1,97 @@
+#pragma once
+#include <vector>
+#include <random>
+#include "instancia.h"
+#include "solucion.h"
+#include "algoritmo.h"
+
+using namespace std;
+
+// parámetros del motor genético híbrido (memético)
+struct ParametrosGenetico {
+    int tamanoPoblacion = 20;           // individuos que sobreviven a cada generación
+    int hijosPorGeneracion = 20;        // hijos generados (y educados en paralelo) por generación
+    int maxGeneraciones = 500;          // presupuesto si no hay límite de tiempo
+    long long iteracionesEducacion = 20000; // largo del SA corto que educa a cada hijo
+    int elitesProtegidos = 8;           // peso de la calidad frente a la diversidad en la aptitud
+    int vecinosDiversidad = 3;          // vecinos más cercanos para medir la contribución a la diversidad
+    double distanciaClon = 0.02;        // por debajo de esta distancia dos individuos son clones
+    int numHilos = 0;                   // hilos para educar hijos (0: uno por núcleo)
+};
+
+// búsqueda genética híbrida: cada individuo es un "giant tour" (todas las granjas en orden)
+// que un split óptimo reparte en rutas consecutivas respetando la capacidad de cada camión
+// y valorando cada ruta con la calidad más baja que recoge. los hijos se obtienen con
+// cruce OX, se educan con un SA corto y entran a una población cuya supervivencia combina
+// calidad y contribución a la diversidad (aptitud sesgada).
+class AlgoritmoGenetico {
+public:
+    AlgoritmoGenetico(const Instancia& inst, long seed, const ParametrosGenetico& params = ParametrosGenetico());
+
+    Solucion ejecutar();
+
+    ParametrosPenalizacion parametrosPenalizacion;
+
+    // igual que en Algoritmo: límite de tiempo de pared, progreso en vivo y cancelación
+    double limiteSegundos = 0.0;
+    ProgresoSA* progreso = nullptr;
+    const TokenCancelacion* cancelacion = nullptr;
+    const CotaSuperior* cotaSuperior = nullptr;
+    double epsilonBrecha = 0.0;
+
+    // resultados de la última ejecución. en el historial, 'iteracion' cuenta las
+    // iteraciones de educación acumuladas, para comparar con el SA en el mismo eje.
+    vector<RegistroConvergencia> historialConvergencia;
+    int generaciones = 0;
+    long long iteracionesEducacion = 0;
+    double tiempoPrimerFactible = -1.0;
+    long long iteracionPrimerFactible = -1;
+    bool cancelada = false;
+    bool terminadaPorBrecha = false;
+
+private:
+    struct Individuo {
+        Solucion sol;
+        Infactibilidad inf;
+        double energia = 0.0;
+        vector<pair<int, int>> aristas; // ordenadas, para la distancia entre individuos
+        double aptitud = 0.0;           // aptitud sesgada (menor es mejor)
+    };
+
+    // split: reparte el giant tour entre los camiones (programación dinámica sobre
+    // segmentos consecutivos). las granjas que no caben en ningún camión quedan sin visitar.
+    Solucion split(const vector<int>& tour) const;
+
+    // giant tour de una solución: rutas concatenadas y luego las no visitadas
+    vector<int> giantTour(const Solucion& sol) const;
+
+    // cruce OX: copia un segmento del primer padre y completa en el orden del segundo
+    vector<int> cruceOX(const vector<int>& a, const vector<int>& b, mt19937& gen) const;
+
+    // SA corto desde 'sol' con las temperaturas calibradas al inicio. 'limite' es el tiempo que
+    // le queda a la ejecución (0: sin límite); en 'iteraciones' deja las que efectivamente hizo.
+    Solucion educar(const Solucion& sol, long semilla, double limite, long long& iteraciones) const;
+
+    Individuo crearIndividuo(Solucion sol) const;
+    bool mejorQue(const Individuo& a, const Individuo& b) const;
+    double distancia(const Individuo& a, const Individuo& b) const;
+
+    // recalcula la aptitud sesgada de toda la población
+    void calcularAptitud();
+
+    // agrega los hijos y descarta clones y luego los de peor aptitud hasta 'tamanoPoblacion'
+    void seleccionarSobrevivientes(vector<Individuo>& hijos);
+
+    const Instancia& inst;
+    long seed;
+    mt19937 rng;
+    ParametrosGenetico params;
+    Algoritmo evaluador;                // mide infactibilidades y calibra la educación
+
+    vector<int> ordenCamiones;          // camiones de mayor a menor capacidad (orden del split)
+    double tempEducacionInicial = 0.0;
+    double tempEducacionFinal = 0.0;
+    double tasaEducacion = 0.0;
+
+    vector<Individuo> poblacion;
+};
@@ -15,10 +15,15 @@ struct Punto {
 class Graficador {
 public:
     static void generarSVG(const std::string& archivoCSV, const std::string& archivoSalida) {
-        std::vector<Punto> datos = leerCSV(archivoCSV);
+        generarSVG(leerCSV(archivoCSV), archivoSalida);
+    }
+
+    // igual que la anterior, con los puntos ya en memoria (sin pasar por el CSV).
+    // el SVG se arma completo en memoria y se escribe de una vez.
+    static void generarSVG(const std::vector<Punto>& datos, const std::string& archivoSalida) {
         if (datos.empty()) return;
 
-        std::ofstream svg(archivoSalida);
+        std::ostringstream svg;
         
         // Configuración del lienzo
         double width = 800;
@@ -71,7 +76,9 @@ public:
         svg << "<text x=\"" << width - padding << "\" y=\"" << height - padding + 20 << "\" text-anchor=\"middle\" font-family=\"Arial\" font-size=\"12\">Iter: " << (int)maxX << "</text>\n";
         
         svg << "</svg>";
-        svg.close();
+
+        std::ofstream salida(archivoSalida);
+        salida << svg.str();
     }
 
 private:
@@ -0,0 +1,72 @@
+#include "indice_espacial.h"
+#include <algorithm>
+#include <cmath>
+
+IndiceEspacial::IndiceEspacial(const Instancia& inst, double nodosPorCelda) {
+    vector<Punto> puntos;
+    puntos.push_back({inst.planta.id, inst.planta.x, inst.planta.y});
+    for (const Nodo& granja : inst.granjas) puntos.push_back({granja.id, granja.x, granja.y});
+
+    double maxX = puntos[0].x, maxY = puntos[0].y;
+    minX = puntos[0].x;
+    minY = puntos[0].y;
+    for (const Punto& p : puntos) {
+        minX = min(minX, p.x);
+        minY = min(minY, p.y);
+        maxX = max(maxX, p.x);
+        maxY = max(maxY, p.y);
+    }
+
+    // celdas cuadradas con 'nodosPorCelda' nodos en promedio
+    double ancho = max(maxX - minX, 1e-9), alto = max(maxY - minY, 1e-9);
+    double numCeldas = max(1.0, puntos.size() / nodosPorCelda);
+    lado = max(sqrt(ancho * alto / numCeldas), 1e-9);
+    columnas = min(1024, (int)(ancho / lado) + 1);
+    filas = min(1024, (int)(alto / lado) + 1);
+
+    celdas.assign(columnas * filas, {});
+    for (const Punto& p : puntos) celdas[celdaY(p.y) * columnas + celdaX(p.x)].push_back(p);
+}
+
+int IndiceEspacial::celdaX(double x) const {
+    return max(0, min(columnas - 1, (int)((x - minX) / lado)));
+}
+
+int IndiceEspacial::celdaY(double y) const {
+    return max(0, min(filas - 1, (int)((y - minY) / lado)));
+}
+
+void IndiceEspacial::vecinos(double x, double y, int k, int excluir, vector<int>& salida) const {
+    salida.clear();
+    if (k <= 0) return;
+
+    candidatos.clear();
+    int cx = celdaX(x), cy = celdaY(y);
+    int maxAnillo = max(columnas, filas);
+
+    for (int r = 0; r <= maxAnillo; ++r) {
+        // celdas del anillo r (borde del cuadrado de lado 2r+1 centrado en la celda del punto)
+        for (int fy = cy - r; fy <= cy + r; ++fy) {
+            if (fy < 0 || fy >= filas) continue;
+            bool borde = (fy == cy - r || fy == cy + r);
+            for (int fx = cx - r; fx <= cx + r; fx += (borde || r == 0) ? 1 : 2 * r) {
+                if (fx < 0 || fx >= columnas) continue;
+                for (const Punto& p : celdas[fy * columnas + fx]) {
+                    if (p.id == excluir) continue;
+                    candidatos.push_back({(p.x - x) * (p.x - x) + (p.y - y) * (p.y - y), p.id});
+                }
+            }
+        }
+
+        // cualquier nodo fuera de los anillos ya vistos está al menos a r*lado del punto
+        if ((int)candidatos.size() >= k) {
+            nth_element(candidatos.begin(), candidatos.begin() + (k - 1), candidatos.end());
+            double limite = r * lado;
+            if (candidatos[k - 1].first <= limite * limite) break;
+        }
+    }
+
+    int n = min(k, (int)candidatos.size());
+    partial_sort(candidatos.begin(), candidatos.begin() + n, candidatos.end());
+    for (int i = 0; i < n; ++i) salida.push_back(candidatos[i].second);
+}
@@ -0,0 +1,34 @@
+#pragma once
+#include <vector>
+#include "instancia.h"
+
+using namespace std;
+
+// índice espacial de grilla uniforme sobre las coordenadas de los nodos (planta incluida).
+// las celdas se dimensionan para tener unos pocos nodos cada una, así buscar los k más
+// cercanos recorre solo los anillos de celdas alrededor del punto.
+class IndiceEspacial {
+public:
+    explicit IndiceEspacial(const Instancia& inst, double nodosPorCelda = 2.0);
+
+    // los 'k' nodos más cercanos a (x, y) ordenados por distancia, sin 'excluir'
+    void vecinos(double x, double y, int k, int excluir, vector<int>& salida) const;
+
+private:
+    int celdaX(double x) const;
+    int celdaY(double y) const;
+
+    struct Punto {
+        int id;
+        double x, y;
+    };
+
+    double minX = 0.0, minY = 0.0;
+    double lado = 1.0;               // lado de cada celda
+    int columnas = 1, filas = 1;
+    vector<vector<Punto>> celdas;    // fila * columnas + columna
+
+    // candidatos (distancia², id) de la última consulta: se reutiliza para no reservar memoria
+    // en cada llamada (cada Algoritmo tiene su propio índice, que no se comparte entre hilos)
+    mutable vector<pair<double, int>> candidatos;
+};
@@ -1,22 +1,52 @@
 #include "instancia.h"
 #include <fstream>
 #include <sstream>
+#include <stdexcept>
 
 Instancia::Instancia(const string& path) {
     if (!leer(path)) {
-        cerr << "Error: No se pudo leer el archivo de instancia en " << path << endl;
-        exit(1);
+        throw runtime_error("No se pudo leer el archivo de instancia en " + path);
     }
+    string error = construirIndices();
+    if (!error.empty()) {
+        throw runtime_error("Instancia inválida en " + path + ": " + error);
+    }
+    calcularMatrizDistancias();
+}
+
+Instancia::Instancia(istream& entrada) {
+    if (!leer(entrada)) {
+        throw runtime_error("No se pudo leer la instancia");
+    }
+    string error = construirIndices();
+    if (!error.empty()) {
+        throw runtime_error("Instancia inválida: " + error);
+    }
+    calcularMatrizDistancias();
+}
+
+Instancia::Instancia(const vector<int>& capacidades, const vector<int>& cuotas,
+                     const vector<double>& ingresos, const Nodo& p, const vector<Nodo>& g)
+    : numCamiones(capacidades.size()), numTiposLeche(cuotas.size()), numNodos(g.size() + 1),
+      planta(p), granjas(g), capacidadesCamiones(capacidades), cuotasLeche(cuotas), ingresosLeche(ingresos) {
+    if (ingresosLeche.size() != cuotasLeche.size()) {
+        throw invalid_argument("Se requiere un ingreso por cada tipo de leche");
+    }
+    string error = construirIndices();
+    if (!error.empty()) throw invalid_argument(error);
     calcularMatrizDistancias();
 }
 
 bool Instancia::leer(const string& path) {
     ifstream file(path);
     if (!file.is_open()) return false;
+    return leer(file);
+}
 
-    string line;
+bool Instancia::leer(istream& file) {
 
     file >> numCamiones;
+    if (!file || numCamiones < 0) return false;
     capacidadesCamiones.resize(numCamiones);
 
 
@@ -25,6 +55,7 @@ bool Instancia::leer(const string& path) {
     }
  
     file >> numTiposLeche;
+    if (!file || numTiposLeche < 0) return false;
     cuotasLeche.resize(numTiposLeche);
     ingresosLeche.resize(numTiposLeche);
  
@@ -37,14 +68,7 @@ bool Instancia::leer(const string& path) {
     }
 
     file >> numNodos;
-
-
-    char tipoChar = 'A';
-    for(int i = 0; i < numTiposLeche; ++i) {
-        tipoLecheToIndex[tipoChar] = i;
-        ingresosPorTipo[tipoChar] = ingresosLeche[i];
-        tipoChar++; // 'A' -> 'B' -> 'C'
-    }
+    if (!file || numNodos < 1) return false;
 
     // leer cada nodo
     for (int i = 0; i < numNodos; ++i) {
@@ -61,11 +85,44 @@ bool Instancia::leer(const string& path) {
         } else {
             granjas.push_back(n);
         }
-        nodosMap[n.id] = n;
     }
 
-    file.close();
-    return true;
+    // si el flujo falló en algún punto, el contenido estaba truncado o mal formado
+    return !file.fail();
+}
+
+string Instancia::construirIndices() {
+    if (numCamiones <= 0) return "Se requiere al menos un camión";
+    if (numTiposLeche <= 0 || numTiposLeche > 26) return "Número de tipos de leche inválido";
+    if (planta.id != 1) return "La planta debe tener id 1";
+
+    tipoLecheToIndex.clear();
+    ingresosPorTipo.clear();
+    char tipoChar = 'A';
+    for(int i = 0; i < numTiposLeche; ++i) {
+        tipoLecheToIndex[tipoChar] = i;
+        ingresosPorTipo[tipoChar] = ingresosLeche[i];
+        tipoChar++; // 'A' -> 'B' -> 'C'
+    }
+
+    // los ids deben ser 1..numNodos sin repetir (la matriz de distancias se indexa por id)
+    nodosMap.clear();
+    nodosMap[planta.id] = planta;
+    for (const Nodo& granja : granjas) {
+        if (granja.id < 2 || granja.id > numNodos || nodosMap.count(granja.id)) {
+            return "Id de granja inválido o repetido: " + to_string(granja.id);
+        }
+        if (!tipoLecheToIndex.count(granja.tipoLeche)) {
+            return "Tipo de leche desconocido en la granja " + to_string(granja.id);
+        }
+        if (granja.cantidadLeche < 0) {
+            return "Cantidad de leche negativa en la granja " + to_string(granja.id);
+        }
+        nodosMap[granja.id] = granja;
+    }
+    if ((int)nodosMap.size() != numNodos) return "Faltan nodos: se esperaban " + to_string(numNodos);
+
+    return "";
 }
 
 void Instancia::calcularMatrizDistancias() {
@@ -88,4 +145,4 @@ double Instancia::getDistancia(int idNodo1, int idNodo2) const {
 
 const Nodo& Instancia::getNodo(int idNodo) const {
     return nodosMap.at(idNodo);
-}
\ No newline at end of file
+}
@@ -8,6 +8,8 @@
 using namespace std;
 
 class Instancia {
+    friend struct AccesoBench; // micro-benchmarks de los núcleos privados (src/bench.cpp)
+
 public:
     int numCamiones;
     int numTiposLeche;
@@ -28,11 +30,21 @@ public:
     vector<vector<double>> distancias;
 
 public:
-    // constructor que llama al parser
+    // constructor que llama al parser. lanza runtime_error si el archivo no se puede leer
+    // o su contenido no es una instancia válida.
     Instancia(const string& path);
 
+    // igual que el anterior, leyendo el contenido del archivo desde un flujo
+    explicit Instancia(istream& entrada);
+
+    // constructor en memoria (sin archivos): la planta debe tener id 1 y las granjas ids 2..n.
+    // lanza invalid_argument si los datos no forman una instancia válida.
+    Instancia(const vector<int>& capacidadesCamiones, const vector<int>& cuotasLeche,
+              const vector<double>& ingresosLeche, const Nodo& planta, const vector<Nodo>& granjas);
+
     // función para leer y parsear el archivo
     bool leer(const string& path);
+    bool leer(istream& file);
 
     // función auxiliar para obtener la distancia entre dos IDs de nodo
     double getDistancia(int idNodo1, int idNodo2) const;
@@ -44,4 +56,7 @@ private:
     // mapa para buscar nodos por ID rápidamente
     map<int, Nodo> nodosMap;
     void calcularMatrizDistancias();
+
+    // construye los mapeos y valida la consistencia de los datos; devuelve el error o "" si es válida
+    string construirIndices();
 };
\ No newline at end of file
@@ -0,0 +1,150 @@
+#include "islas.h"
+#include "migracion.h"
+#include "instancia.h"
+#include <iostream>
+#include <iomanip>
+#include <sstream>
+#include <chrono>
+#include <stdexcept>
+#include <filesystem>
+#include <unistd.h>
+#include <sys/wait.h>
+
+namespace fs = std::filesystem;
+
+// código que corre en el proceso hijo: resuelve y escribe el resultado en 'fdSalida'
+static void ejecutarIslaHijo(const Instancia& instancia, int id, int numIslas, const string& directorio,
+                             const ParametrosSA& params, int intervaloMigracion, long semilla, int fdSalida) {
+    // el log del SA no debe mezclarse con la salida del proceso padre
+    ostringstream log;
+    auto* coutBuf_original = cout.rdbuf(log.rdbuf());
+
+    ostringstream resultado;
+    try {
+        CanalUnixSocket canal(directorio, id, numIslas);
+
+        Algoritmo algo(instancia, semilla);
+        algo.canalMigracion = &canal;
+        algo.idIsla = id;
+        algo.intervaloMigracion = intervaloMigracion;
+
+        auto inicio = chrono::steady_clock::now();
+        Solucion sol = algo.ejecutarSimulatedAnnealing(params);
+        double segundos = chrono::duration<double>(chrono::steady_clock::now() - inicio).count();
+
+        ostringstream salida;
+        cout.rdbuf(salida.rdbuf());
+        sol.imprimirFormatoSalida(semilla, instancia);
+
+        // cabecera de una línea seguida de la solución formateada
+        resultado << id << " " << fixed << setprecision(2) << sol.profit << " " << sol.esFactible << " "
+                  << algo.iteracionesRealizadas << " " << setprecision(6) << segundos << " "
+                  << algo.migrantesAdoptados << "\n" << salida.str();
+    } catch (const exception& e) {
+        cerr << "Isla " << id << ": " << e.what() << endl;
+    }
+    cout.rdbuf(coutBuf_original);
+
+    string datos = resultado.str();
+    size_t escritos = 0;
+    while (escritos < datos.size()) {
+        ssize_t n = write(fdSalida, datos.data() + escritos, datos.size() - escritos);
+        if (n <= 0) break;
+        escritos += n;
+    }
+    close(fdSalida);
+}
+
+ResultadoIslas ejecutarIslas(const string& pathInstancia, int numIslas, const ParametrosSA& params,
+                             int intervaloMigracion, long semillaBase) {
+    // se parsea una vez y los hijos heredan la instancia al hacer fork
+    Instancia instancia(pathInstancia);
+
+    string directorio = (fs::temp_directory_path() / ("mcwb-islas-" + to_string(getpid()))).string();
+    fs::create_directories(directorio);
+
+    ResultadoIslas res;
+    res.numIslas = numIslas;
+    auto inicio = chrono::steady_clock::now();
+
+    vector<pid_t> hijos;
+    vector<int> tuberias;
+    for (int i = 0; i < numIslas; ++i) {
+        int fds[2];
+        if (pipe(fds) < 0) throw runtime_error("No se pudo crear la tubería de la isla " + to_string(i));
+
+        cout.flush();
+        pid_t pid = fork();
+        if (pid < 0) throw runtime_error("No se pudo crear el proceso de la isla " + to_string(i));
+
+        if (pid == 0) {
+            close(fds[0]);
+            for (int fd : tuberias) close(fd);
+            ejecutarIslaHijo(instancia, i, numIslas, directorio, params, intervaloMigracion, semillaBase + i, fds[1]);
+            _exit(0);
+        }
+
+        close(fds[1]);
+        hijos.push_back(pid);
+        tuberias.push_back(fds[0]);
+    }
+
+    // leer cada tubería hasta EOF (los hijos escriben al terminar)
+    for (int i = 0; i < numIslas; ++i) {
+        string datos;
+        char buffer[4096];
+        ssize_t n;
+        while ((n = read(tuberias[i], buffer, sizeof(buffer))) > 0) datos.append(buffer, n);
+        close(tuberias[i]);
+        waitpid(hijos[i], nullptr, 0);
+
+        istringstream ss(datos);
+        ResultadoIsla isla;
+        if (!(ss >> isla.id >> isla.profit >> isla.esFactible >> isla.iteraciones >> isla.segundos >> isla.migrantesAdoptados)) {
+            cerr << "Isla " << i << " terminó sin resultado." << endl;
+            continue;
+        }
+        ss.ignore(1); // salto de línea de la cabecera
+        isla.salida = datos.substr(ss.tellg());
+        res.islas.push_back(isla);
+    }
+
+    res.segundos = chrono::duration<double>(chrono::steady_clock::now() - inicio).count();
+    fs::remove_all(directorio);
+
+    for (size_t i = 0; i < res.islas.size(); ++i) {
+        const ResultadoIsla& r = res.islas[i];
+        if (res.mejor < 0) { res.mejor = i; continue; }
+        const ResultadoIsla& m = res.islas[res.mejor];
+        if (r.esFactible != m.esFactible ? r.esFactible : r.profit > m.profit) res.mejor = i;
+    }
+    return res;
+}
+
+void reportarEscalamiento(const string& pathInstancia, int maxIslas, const ParametrosSA& params,
+                          int intervaloMigracion, long semillaBase) {
+    vector<int> cantidades;
+    for (int n = 1; n < maxIslas; n *= 2) cantidades.push_back(n);
+    cantidades.push_back(maxIslas);
+
+    cout << "Escalamiento del modelo de islas: " << pathInstancia << endl;
+    cout << left << setw(8) << "Islas" << setw(12) << "Tiempo(s)" << setw(16) << "Iter/s total"
+         << setw(12) << "Eficiencia" << setw(14) << "Mejor profit" << "Factible" << endl;
+
+    double throughputBase = 0.0;
+    for (int n : cantidades) {
+        ResultadoIslas res = ejecutarIslas(pathInstancia, n, params, intervaloMigracion, semillaBase);
+        if (res.mejor < 0) continue;
+
+        long long iteraciones = 0;
+        for (const auto& isla : res.islas) iteraciones += isla.iteraciones;
+        double throughput = iteraciones / res.segundos;
+        if (n == 1) throughputBase = throughput;
+        double eficiencia = throughputBase > 0 ? throughput / (n * throughputBase) : 0.0;
+
+        const ResultadoIsla& mejor = res.islas[res.mejor];
+        cout << left << setw(8) << n << setw(12) << fixed << setprecision(3) << res.segundos
+             << setw(16) << setprecision(0) << throughput << setw(12) << setprecision(2) << eficiencia
+             << setw(14) << setprecision(0) << mejor.profit << (mejor.esFactible ? "Si" : "No") << endl;
+    }
+}
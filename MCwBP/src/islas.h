@@ -0,0 +1,35 @@
+#pragma once
+#include <string>
+#include <vector>
+#include "algoritmo.h"
+
+using namespace std;
+
+// resultado de una isla (un proceso hijo)
+struct ResultadoIsla {
+    int id;
+    double profit;
+    bool esFactible;
+    long long iteraciones;
+    double segundos;
+    int migrantesAdoptados;
+    string salida; // solución en formato de salida estándar
+};
+
+// resultado de una ejecución completa del modelo de islas
+struct ResultadoIslas {
+    int numIslas;
+    double segundos;           // tiempo de pared de toda la ejecución
+    vector<ResultadoIsla> islas;
+    int mejor = -1;            // índice de la mejor isla en 'islas'
+};
+
+// lanza 'numIslas' procesos que ejecutan SA sobre la misma instancia con semillas distintas
+// e intercambian su mejor solución cada 'intervaloMigracion' iteraciones por sockets Unix.
+ResultadoIslas ejecutarIslas(const string& pathInstancia, int numIslas, const ParametrosSA& params,
+                             int intervaloMigracion, long semillaBase);
+
+// ejecuta el modelo con 1, 2, 4, ... hasta 'maxIslas' procesos e imprime la eficiencia de
+// escalamiento (iteraciones por segundo agregadas respecto de un proceso)
+void reportarEscalamiento(const string& pathInstancia, int maxIslas, const ParametrosSA& params,
+                          int intervaloMigracion, long semillaBase);
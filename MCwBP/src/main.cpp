@@ -4,41 +4,379 @@
 #include <ctime>     
 #include <filesystem> 
 #include <fstream>    
-#include <streambuf>  
+#include <sstream>
+#include <iomanip>
 #include <functional> 
 #include <chrono>
+#include <cmath>
+#include <limits>
+#include <algorithm>
+#include <unistd.h>
 
-#include "instancia.h" 
-#include "algoritmo.h" 
-#include "solucion.h"  
-#include "graficador.h" 
+#include "solver.h"
+#include "islas.h"
+#include "reoptimizacion.h"
+#include "servicio.h"
+#include "escritor_resultados.h"
+#include "descomposicion.h"
 
 namespace fs = std::filesystem; 
 using namespace std;
 using namespace std::chrono;
 
-int main() {
+// modo islas: bin/mcwb --islas N --instancia archivo [--intervalo K] [--escalamiento]
+static int ejecutarModoIslas(const string& pathInstancia, int numIslas, int intervalo, bool escalamiento,
+                             const ParametrosSA& params) {
+    long semilla = time(nullptr);
+    try {
+        if (escalamiento) {
+            reportarEscalamiento(pathInstancia, numIslas, params, intervalo, semilla);
+            return 0;
+        }
+
+        ResultadoIslas res = ejecutarIslas(pathInstancia, numIslas, params, intervalo, semilla);
+        if (res.mejor < 0) {
+            cerr << "Ninguna isla produjo resultado." << endl;
+            return 1;
+        }
+
+        cout << "Islas: " << res.numIslas << ", Tiempo: " << fixed << setprecision(3) << res.segundos << "s" << endl;
+        for (const auto& isla : res.islas) {
+            cout << "Isla " << isla.id << ": profit " << setprecision(0) << isla.profit
+                 << ", factible " << (isla.esFactible ? "Si" : "No")
+                 << ", iteraciones " << isla.iteraciones
+                 << ", migrantes adoptados " << isla.migrantesAdoptados << endl;
+        }
+        const ResultadoIsla& mejor = res.islas[res.mejor];
+        cout << "\n--- Mejor Solución (isla " << mejor.id << ") ---" << endl;
+        cout << mejor.salida;
+        cout << "Factible: " << (mejor.esFactible ? "Si" : "No") << endl;
+    } catch (const exception& e) {
+        cerr << "ERROR: " << e.what() << endl;
+        return 1;
+    }
+    return 0;
+}
+
+// modo re-optimización: bin/mcwb --reoptimizar plan --instancia archivo [--fraccion f] [--comparar]
+// toma el plan de ayer, lo repara sobre la instancia de hoy y ejecuta un SA corto y frío
+static int ejecutarModoReoptimizacion(const string& pathPlan, const string& pathInstancia, double fraccionIteraciones,
+                                      bool comparar, const ParametrosSA& params, const string& resultsDir) {
+    try {
+        PlanPrevio plan = leerPlan(pathPlan);
+        Instancia instancia(pathInstancia);
+        long seed = time(nullptr);
+
+        auto inicio = high_resolution_clock::now();
+
+        // el log del SA no interesa en este modo
+        Algoritmo algo(instancia, seed);
+        algo.mostrarLog = false;
+        ReporteReoptimizacion reporte;
+        vector<vector<int>> rutasTraducidas;
+        Solucion reparada = repararPlan(plan, instancia, algo, reporte, rutasTraducidas);
+
+        // SA corto: una fracción del presupuesto, partiendo frío (la mediana de los
+        // empeoramientos se acepta con prob. 0.1 en vez de los saltos grandes con 0.5)
+        CalibracionTemperatura cal = algo.calibrarTemperaturas(reparada, params.muestrasCalibracion, 0.1,
+                                                               params.probAceptacionFinal, 0.5, 0.1);
+        double iteraciones = fraccionIteraciones * log(params.tempFinal / params.tempInicial) / log(params.tasaEnfriamiento);
+        double tasa = pow(cal.tempFinal / cal.tempInicial, 1.0 / max(1.0, iteraciones));
+        Solucion solFinal = algo.ejecutarSimulatedAnnealing(reparada, cal.tempInicial, cal.tempFinal, tasa);
+
+        double tiempoSegundos = duration_cast<milliseconds>(high_resolution_clock::now() - inicio).count() / 1000.0;
+        compararConPlanPrevio(solFinal, rutasTraducidas, instancia, reporte);
+
+        cout << "Instancia: " << fs::path(pathInstancia).filename().string() << endl;
+        cout << "Plan anterior: " << pathPlan << endl;
+        cout << "Granjas del plan: " << reporte.granjasPrevias << " (conservadas: " << reporte.granjasConservadas
+             << ", eliminadas: " << reporte.granjasEliminadas << "), nuevas: " << reporte.granjasNuevas << endl;
+        cout << "Removidas por capacidad: " << reporte.removidasPorCapacidad
+             << ", rutas sin camion: " << reporte.rutasSinCamion << endl;
+
+        cout << "\n--- Solución Inicial (Plan Reparado) ---" << endl;
+        cout << "Profit: " << (long)reparada.profit << endl;
+        cout << "Factible: " << (reparada.esFactible ? "Si" : "No") << endl;
+
+        cout << "\n--- Mejor Solución Final (SA corto) ---" << endl;
+        cout << "Tiempo: " << fixed << setprecision(3) << tiempoSegundos << "s" << endl;
+        solFinal.imprimirFormatoSalida(seed, instancia);
+        cout << "Factible: " << (solFinal.esFactible ? "Si" : "No") << endl;
+        cout << "Aristas del plan conservadas: " << setprecision(1) << 100.0 * reporte.fraccionAristasConservadas << "%" << endl;
+        cout << "Granjas en el mismo camion: " << 100.0 * reporte.fraccionMismoCamion << "%" << endl;
+
+        guardarPlan(resultsDir + fs::path(pathInstancia).filename().string() + ".plan", solFinal, instancia);
+
+        if (comparar) {
+            // referencia: resolver desde cero con el esquema completo
+            auto inicioFrio = high_resolution_clock::now();
+            ParametrosSolver parametrosFrio;
+            parametrosFrio.sa = params;
+            parametrosFrio.semilla = seed;
+            Solucion solFrio = resolver(instancia, parametrosFrio).solucion;
+            double tiempoFrio = duration_cast<milliseconds>(high_resolution_clock::now() - inicioFrio).count() / 1000.0;
+
+            cout << "\n--- Comparacion con arranque en frio ---" << endl;
+            cout << "Frio: profit " << setprecision(0) << solFrio.profit << ", factible " << (solFrio.esFactible ? "Si" : "No")
+                 << ", tiempo " << setprecision(3) << tiempoFrio << "s" << endl;
+            cout << "Caliente: profit " << setprecision(0) << solFinal.profit << ", factible " << (solFinal.esFactible ? "Si" : "No")
+                 << ", tiempo " << setprecision(3) << tiempoSegundos << "s (" << setprecision(1)
+                 << 100.0 * tiempoSegundos / max(tiempoFrio, 1e-9) << "% del tiempo)" << endl;
+        }
+    } catch (const exception& e) {
+        cerr << "ERROR: " << e.what() << endl;
+        return 1;
+    }
+    return 0;
+}
+
+// modo servicio: bin/mcwb --servicio [--socket ruta] [--hilos N]
+// sin socket, atiende las solicitudes de stdin y termina al llegar a EOF
+static int ejecutarModoServicio(const string& rutaSocket, int numHilos, const ParametrosSA& params) {
+    try {
+        ParametrosServicio parametros;
+        parametros.numHilos = numHilos;
+        parametros.sa = params;
+        Servicio servicio(parametros);
+
+        if (!rutaSocket.empty()) {
+            cerr << "Servicio escuchando en " << rutaSocket << endl;
+            servicio.escuchar(rutaSocket);
+        } else {
+            servicio.atender(STDIN_FILENO, STDOUT_FILENO);
+            servicio.esperar();
+            cerr << servicio.resumenMetricas();
+        }
+    } catch (const exception& e) {
+        cerr << "ERROR: " << e.what() << endl;
+        return 1;
+    }
+    return 0;
+}
+
+// comparación de motores: bin/mcwb --comparar-motores [--segundos S] [--instancia archivo]
+// ejecuta SA y genético con el mismo presupuesto de tiempo de pared sobre cada instancia
+static int ejecutarComparacionMotores(const vector<fs::path>& instancias, double segundos, const ParametrosSA& params) {
+    cout << "Comparacion de motores, " << fixed << setprecision(1) << segundos << "s por ejecucion" << endl;
+    cout << left << setw(14) << "Instancia" << setw(14) << "SA profit" << setw(10) << "SA fact." << setw(10) << "SA t(s)"
+         << setw(14) << "Gen. profit" << setw(12) << "Gen. fact." << setw(11) << "Gen. t(s)" << "Generaciones" << endl;
+
+    for (const auto& entry : instancias) {
+        if (entry.extension() != ".txt") continue;
+        try {
+            Instancia instancia(entry.string());
+            long semilla = time(nullptr) + std::hash<string>{}(entry.filename().string());
+
+            ParametrosSolver parametros;
+            parametros.sa = params;
+            // el presupuesto de iteraciones del SA no debe agotarse antes que el de tiempo
+            parametros.sa.tasaEnfriamiento = 1.0 - 1e-9;
+            parametros.limiteSegundos = segundos;
+            parametros.semilla = semilla;
+            ResultadoSolver sa = resolver(instancia, parametros);
+
+            parametros.motor = MotorBusqueda::Genetico;
+            parametros.genetico.maxGeneraciones = numeric_limits<int>::max();
+            ResultadoSolver gen = resolver(instancia, parametros);
+
+            cout << left << setw(14) << entry.filename().string() << setprecision(0)
+                 << setw(14) << sa.solucion.profit << setw(10) << (sa.solucion.esFactible ? "Si" : "No")
+                 << setw(10) << setprecision(2) << sa.estadisticas.segundos << setprecision(0)
+                 << setw(14) << gen.solucion.profit << setw(12) << (gen.solucion.esFactible ? "Si" : "No")
+                 << setw(11) << setprecision(2) << gen.estadisticas.segundos << gen.estadisticas.generaciones << endl;
+        } catch (const exception& e) {
+            cerr << entry.filename().string() << ": ERROR: " << e.what() << endl;
+        }
+    }
+    return 0;
+}
+
+// descomposición: bin/mcwb --descomponer [--camiones-por-cluster C] [--segundos S] [--hilos N] [--comparar] [--instancia archivo]
+// resuelve cada instancia por clusters y, con --comparar, también de forma monolítica con el mismo SA
+static int ejecutarModoDescomposicion(const vector<fs::path>& instancias, int camionesPorCluster, double segundos,
+                                      int numHilos, bool comparar, const ParametrosSA& params) {
+    cout << "Descomposicion por clusters (" << camionesPorCluster << " camion(es) por cluster)" << endl;
+    cout << left << setw(14) << "Instancia" << setw(10) << "Clusters" << setw(14) << "Desc. profit" << setw(12) << "Desc. fact."
+         << setw(11) << "Desc. t(s)" << setw(10) << "Frontera";
+    if (comparar) cout << setw(14) << "Mono. profit" << setw(12) << "Mono. fact." << setw(11) << "Mono. t(s)" << "Dif.";
+    cout << endl;
+
+    for (const auto& entry : instancias) {
+        if (entry.extension() != ".txt") continue;
+        try {
+            Instancia instancia(entry.string());
+            long semilla = time(nullptr) + std::hash<string>{}(entry.filename().string());
+
+            ParametrosDescomposicion pd;
+            pd.camionesPorCluster = camionesPorCluster;
+            pd.limiteSegundos = segundos;
+            pd.numHilos = numHilos;
+            pd.sa = params;
+            ResultadoDescomposicion desc = resolverPorDescomposicion(instancia, pd, semilla);
+
+            cout << left << setw(14) << entry.filename().string() << setw(10) << desc.numClusters << fixed << setprecision(0)
+                 << setw(14) << desc.solucion.profit << setw(12) << (desc.solucion.esFactible ? "Si" : "No")
+                 << setw(11) << setprecision(2) << desc.segundos << setw(10) << desc.movimientosFrontera;
+            if (comparar) {
+                ParametrosSolver parametros;
+                parametros.sa = params;
+                parametros.limiteSegundos = segundos;
+                parametros.semilla = semilla;
+                ResultadoSolver mono = resolver(instancia, parametros);
+                cout << setprecision(0) << setw(14) << mono.solucion.profit << setw(12) << (mono.solucion.esFactible ? "Si" : "No")
+                     << setw(11) << setprecision(2) << mono.estadisticas.segundos
+                     << setprecision(2) << 100.0 * (desc.solucion.profit - mono.solucion.profit) / fabs(mono.solucion.profit) << "%";
+            }
+            cout << endl;
+        } catch (const exception& e) {
+            cerr << entry.filename().string() << ": ERROR: " << e.what() << endl;
+        }
+    }
+    return 0;
+}
+
+int main(int argc, char* argv[]) {
     const string instanciaDir = "instancias/";
     const string resultsDir = "results/";
     const string graficosDir = "graficos/"; 
 
+    double tempInicial = 100000.0;
+    double tempFinal = 1.0;
+    double tasaEnfriamiento = 0.9999995; 
+
+    // calibración automática: reemplaza tempInicial/tempFinal por valores estimados de la
+    // instancia, manteniendo el mismo presupuesto de iteraciones del esquema anterior
+    bool calibrarTemperatura = true;
+    int muestrasCalibracion = 2000;
+    double probAceptacionInicial = 0.5;   // prob. de aceptar un empeoramiento grande (percentil 90) al inicio
+    double probAceptacionFinal = 0.01;    // prob. de aceptar un empeoramiento pequeño (percentil 10) al final
+
+    ParametrosSA params;
+    params.tempInicial = tempInicial;
+    params.tempFinal = tempFinal;
+    params.tasaEnfriamiento = tasaEnfriamiento;
+    params.calibrarTemperatura = calibrarTemperatura;
+    params.muestrasCalibracion = muestrasCalibracion;
+    params.probAceptacionInicial = probAceptacionInicial;
+    params.probAceptacionFinal = probAceptacionFinal;
+
+    // argumentos opcionales (sin argumentos se procesa todo 'instancias/')
+    int numIslas = 0;
+    int intervaloMigracion = 100000;
+    bool escalamiento = false;
+    string pathInstanciaUnica;
+    string checkpointDir;
+    string pathPlan;
+    double fraccionReoptimizacion = 0.05;
+    bool comparar = false;
+    long long intervaloCheckpoint = 1000000;
+    bool servicio = false;
+    MotorBusqueda motor = MotorBusqueda::SA;
+    double limiteSegundos = 0.0;
+    bool compararMotores = false;
+    string rutaSocket;
+    int numHilos = 0;
+    double epsilonBrecha = 0.0;
+    bool descomponer = false;
+    int camionesPorCluster = 1;
+    for (int i = 1; i < argc; ++i) {
+        string arg = argv[i];
+        if (arg == "--islas" && i + 1 < argc) numIslas = stoi(argv[++i]);
+        else if (arg == "--intervalo" && i + 1 < argc) intervaloMigracion = stoi(argv[++i]);
+        else if (arg == "--instancia" && i + 1 < argc) pathInstanciaUnica = argv[++i];
+        else if (arg == "--escalamiento") escalamiento = true;
+        else if (arg == "--tasa" && i + 1 < argc) params.tasaEnfriamiento = stod(argv[++i]);
+        else if (arg == "--checkpoint" && i + 1 < argc) checkpointDir = argv[++i];
+        else if (arg == "--reoptimizar" && i + 1 < argc) pathPlan = argv[++i];
+        else if (arg == "--fraccion" && i + 1 < argc) fraccionReoptimizacion = stod(argv[++i]);
+        else if (arg == "--comparar") comparar = true;
+        else if (arg == "--intervalo-checkpoint" && i + 1 < argc) intervaloCheckpoint = stoll(argv[++i]);
+        else if (arg == "--servicio") servicio = true;
+        else if (arg == "--motor" && i + 1 < argc) {
+            string nombre = argv[++i];
+            if (nombre == "sa") motor = MotorBusqueda::SA;
+            else if (nombre == "genetico") motor = MotorBusqueda::Genetico;
+            else { cerr << "Motor desconocido: " << nombre << " (sa|genetico)" << endl; return 1; }
+        }
+        else if (arg == "--segundos" && i + 1 < argc) limiteSegundos = stod(argv[++i]);
+        else if (arg == "--comparar-motores") compararMotores = true;
+        else if (arg == "--socket" && i + 1 < argc) rutaSocket = argv[++i];
+        else if (arg == "--hilos" && i + 1 < argc) numHilos = stoi(argv[++i]);
+        else if (arg == "--epsilon" && i + 1 < argc) epsilonBrecha = stod(argv[++i]);
+        else if (arg == "--descomponer") descomponer = true;
+        else if (arg == "--camiones-por-cluster" && i + 1 < argc) camionesPorCluster = stoi(argv[++i]);
+        else {
+            cerr << "Uso: " << argv[0] << " [--tasa T] [--instancia archivo] [--checkpoint dir [--intervalo-checkpoint K]]"
+                 << " [--motor sa|genetico] [--segundos S] [--epsilon E]" << endl;
+            cerr << "       " << argv[0] << " --comparar-motores [--segundos S] [--instancia archivo]" << endl;
+            cerr << "       " << argv[0] << " [--tasa T] --descomponer [--camiones-por-cluster C] [--segundos S] [--hilos N] [--comparar] [--instancia archivo]" << endl;
+            cerr << "       " << argv[0] << " [--tasa T] --islas N --instancia archivo [--intervalo K] [--escalamiento]" << endl;
+            cerr << "       " << argv[0] << " [--tasa T] --reoptimizar plan --instancia archivo [--fraccion f] [--comparar]" << endl;
+            cerr << "       " << argv[0] << " [--tasa T] --servicio [--socket ruta] [--hilos N]" << endl;
+            return 1;
+        }
+    }
+
+    if (servicio) return ejecutarModoServicio(rutaSocket, numHilos, params);
+
+    if (compararMotores) {
+        vector<fs::path> instancias;
+        if (!pathInstanciaUnica.empty()) instancias.push_back(pathInstanciaUnica);
+        else for (const auto& entry : fs::directory_iterator(instanciaDir)) instancias.push_back(entry.path());
+        sort(instancias.begin(), instancias.end());
+        return ejecutarComparacionMotores(instancias, limiteSegundos > 0.0 ? limiteSegundos : 10.0, params);
+    }
+
+    if (descomponer) {
+        vector<fs::path> instancias;
+        if (!pathInstanciaUnica.empty()) instancias.push_back(pathInstanciaUnica);
+        else for (const auto& entry : fs::directory_iterator(instanciaDir)) instancias.push_back(entry.path());
+        sort(instancias.begin(), instancias.end());
+        return ejecutarModoDescomposicion(instancias, camionesPorCluster, limiteSegundos, numHilos, comparar, params);
+    }
+
+    if (numIslas > 0) {
+        if (pathInstanciaUnica.empty()) {
+            cerr << "El modo islas requiere --instancia." << endl;
+            return 1;
+        }
+        return ejecutarModoIslas(pathInstanciaUnica, numIslas, intervaloMigracion, escalamiento, params);
+    }
+
+    if (!pathPlan.empty()) {
+        if (pathInstanciaUnica.empty()) {
+            cerr << "El modo re-optimización requiere --instancia." << endl;
+            return 1;
+        }
+        if (!fs::exists(resultsDir)) fs::create_directory(resultsDir);
+        return ejecutarModoReoptimizacion(pathPlan, pathInstanciaUnica, fraccionReoptimizacion, comparar, params, resultsDir);
+    }
+
     try {
         if (!fs::exists(resultsDir)) fs::create_directory(resultsDir);
         if (!fs::exists(graficosDir)) fs::create_directory(graficosDir);
+        if (!checkpointDir.empty() && !fs::exists(checkpointDir)) fs::create_directories(checkpointDir);
     } catch (const fs::filesystem_error& e) {
         cerr << "Error creando directorios: " << e.what() << endl;
         return 1;
     }
 
-    double tempInicial = 100000.0;
-    double tempFinal = 1.0;
-    double tasaEnfriamiento = 0.9999995; 
+    // con --instancia se procesa solo ese archivo; si no, todo el directorio
+    vector<fs::path> instancias;
+    if (!pathInstanciaUnica.empty()) {
+        instancias.push_back(pathInstanciaUnica);
+    } else {
+        for (const auto& entry : fs::directory_iterator(instanciaDir)) instancias.push_back(entry.path());
+    }
+
+    // los archivos de cada instancia se escriben en segundo plano mientras se resuelve la siguiente
+    EscritorResultados escritor(resultsDir, graficosDir);
 
-    for (const auto& entry : fs::directory_iterator(instanciaDir)) {
-        const string pathInstancia = entry.path().string();
-        const string filename = entry.path().filename().string();
+    for (const auto& entry : instancias) {
+        const string pathInstancia = entry.string();
+        const string filename = entry.filename().string();
 
-        if (entry.path().extension() != ".txt") continue;
+        if (entry.extension() != ".txt") continue;
 
         cout << "Procesando: " << filename << "..." << flush;
 
@@ -46,63 +384,42 @@ int main() {
         auto inicio_total = high_resolution_clock::now();
 
         try {
-            string pathSalida = resultsDir + filename;
-            ofstream outFile(pathSalida);
-            auto* coutBuf_original = std::cout.rdbuf(); 
-            std::cout.rdbuf(outFile.rdbuf());    
-
-            long seed = time(nullptr) + std::hash<string>{}(filename);
-            Instancia instancia(pathInstancia);
-            
-            cout << "Instancia: " << filename << endl;
-            cout << "Nodos: " << instancia.numNodos << ", Camiones: " << instancia.numCamiones << endl;
-
-            Algoritmo algo(instancia, seed);
-            
-            // 1. generar y evaluar solución inicial
-            Solucion solInicial = algo.generarSolucionInicialGreedy();
-            cout << "\n--- Solución Inicial (Greedy) ---" << endl;
-            cout << "Profit: " << (long)solInicial.profit << endl;
-            cout << "Factible: " << (solInicial.esFactible ? "Si" : "No") << endl;
-
-            // 2. ejecutar SA 
-            cout << "\n--- Ejecutando SA ---" << endl;
-            Solucion solFinal = algo.ejecutarSimulatedAnnealing(tempInicial, tempFinal, tasaEnfriamiento);
-            
+            auto instancia = make_shared<const Instancia>(pathInstancia);
+
+            ParametrosSolver parametros;
+            parametros.sa = params;
+            parametros.semilla = time(nullptr) + std::hash<string>{}(filename);
+            parametros.motor = motor;
+            parametros.limiteSegundos = limiteSegundos;
+            parametros.epsilonBrecha = epsilonBrecha;
+
+            // con checkpoints, si el proceso muere basta con volver a ejecutar el mismo comando
+            if (!checkpointDir.empty()) {
+                parametros.checkpoint.ruta = (fs::path(checkpointDir) / (filename + ".ckpt")).string();
+                parametros.checkpoint.intervalo = intervaloCheckpoint;
+            }
+
+            // Greedy + SA (la solución inicial la genera el solver)
+            ResultadoSolver res = resolver(*instancia, parametros);
+
             // medir fin del tiempo
             auto fin_total = high_resolution_clock::now();
             auto duracion = duration_cast<milliseconds>(fin_total - inicio_total);
             double tiempoSegundos = duracion.count() / 1000.0;
 
-            // 3. resultados finales y tiempos
-            cout << "\n--- Mejor Solución Final (SA) ---" << endl;
-            cout << "Tiempo: " << fixed << setprecision(3) << tiempoSegundos << "s" << endl;
-            solFinal.imprimirFormatoSalida(seed, instancia);
-            cout << "Factible: " << (solFinal.esFactible ? "Si" : "No") << endl;
-
-            // guardado datos de convergencia para graficar
-            string pathCSV = resultsDir + filename + ".csv";
-            ofstream csvFile(pathCSV);
-            csvFile << "Iteracion,Profit\n";
-            for (const auto& p : algo.historialConvergencia) {
-                csvFile << p.first << "," << fixed << setprecision(2) << p.second << "\n";
-            }
-            csvFile.close();
-
-            string pathSVG = graficosDir + filename + ".svg";
-            Graficador::generarSVG(pathCSV, pathSVG);
+            // resultados, plan, CSV y SVG quedan a cargo del escritor
+            escritor.encolar({filename, instancia, std::move(res), motor, tiempoSegundos});
 
-            std::cout.rdbuf(coutBuf_original);
-            outFile.close();
-            
             // mostrar mensaje de completado con tiempo
-            cout << " -> ¡Listo! (" << tiempoSegundos << "s)" << endl;
+            cout << " -> ¡Listo! (" << fixed << setprecision(3) << tiempoSegundos << "s)" << endl;
 
         } catch (const exception& e) {
             cerr << " -> ERROR: " << e.what() << endl;
         }
     }
 
+    // barrera: todo en disco antes de sugerir el análisis
+    escritor.esperar();
     cout << "\nCompletado. Ejecuta './bin/analisis' en la terminal para generar las estadísticas." << endl;
     return 0;
 }
\ No newline at end of file
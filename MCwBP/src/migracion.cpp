@@ -0,0 +1,130 @@
+#include "migracion.h"
+#include <cstring>
+#include <cstdint>
+#include <stdexcept>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+// tamaño máximo de un datagrama aceptado (holgado para instancias de cientos de nodos)
+static const size_t TAMANO_MAXIMO_MENSAJE = 1 << 16;
+
+CanalUnixSocket::CanalUnixSocket(const string& dir, int id, int n)
+    : directorio(dir), idIsla(id), numIslas(n), fd(-1) {
+    fd = socket(AF_UNIX, SOCK_DGRAM, 0);
+    if (fd < 0) throw runtime_error("No se pudo crear el socket de la isla " + to_string(idIsla));
+
+    string ruta = rutaSocket(directorio, idIsla);
+    sockaddr_un addr{};
+    addr.sun_family = AF_UNIX;
+    if (ruta.size() >= sizeof(addr.sun_path)) {
+        close(fd);
+        throw runtime_error("Ruta de socket demasiado larga: " + ruta);
+    }
+    strncpy(addr.sun_path, ruta.c_str(), sizeof(addr.sun_path) - 1);
+
+    unlink(ruta.c_str()); // por si quedó de una ejecución anterior
+    if (bind(fd, (sockaddr*)&addr, sizeof(addr)) < 0) {
+        close(fd);
+        throw runtime_error("No se pudo enlazar el socket " + ruta);
+    }
+}
+
+CanalUnixSocket::~CanalUnixSocket() {
+    if (fd >= 0) {
+        close(fd);
+        unlink(rutaSocket(directorio, idIsla).c_str());
+    }
+}
+
+string CanalUnixSocket::rutaSocket(const string& directorio, int idIsla) {
+    return directorio + "/isla" + to_string(idIsla) + ".sock";
+}
+
+void CanalUnixSocket::publicar(const Migrante& migrante) {
+    string mensaje = serializarMigrante(migrante);
+
+    for (int i = 0; i < numIslas; ++i) {
+        if (i == idIsla) continue;
+
+        sockaddr_un addr{};
+        addr.sun_family = AF_UNIX;
+        strncpy(addr.sun_path, rutaSocket(directorio, i).c_str(), sizeof(addr.sun_path) - 1);
+
+        // sin bloqueo: si la isla destino aún no existe o su cola está llena, se descarta
+        sendto(fd, mensaje.data(), mensaje.size(), MSG_DONTWAIT, (sockaddr*)&addr, sizeof(addr));
+    }
+}
+
+vector<Migrante> CanalUnixSocket::recibir() {
+    vector<Migrante> recibidos;
+    vector<char> buffer(TAMANO_MAXIMO_MENSAJE);
+
+    while (true) {
+        ssize_t n = recv(fd, buffer.data(), buffer.size(), MSG_DONTWAIT);
+        if (n <= 0) break;
+
+        Migrante m;
+        if (deserializarMigrante(buffer.data(), n, m)) {
+            recibidos.push_back(std::move(m));
+        }
+    }
+    return recibidos;
+}
+
+// formato: origen, profit, numRutas, {largo, ids...}, numNoVisitadas, ids...
+string serializarMigrante(const Migrante& migrante) {
+    string out;
+    auto escribirEntero = [&](int32_t v) { out.append((const char*)&v, sizeof(v)); };
+
+    escribirEntero(migrante.origen);
+    out.append((const char*)&migrante.profit, sizeof(migrante.profit));
+
+    escribirEntero(migrante.rutas.size());
+    for (const auto& ruta : migrante.rutas) {
+        escribirEntero(ruta.size());
+        for (int id : ruta) escribirEntero(id);
+    }
+
+    escribirEntero(migrante.granjasNoVisitadas.size());
+    for (int id : migrante.granjasNoVisitadas) escribirEntero(id);
+
+    return out;
+}
+
+bool deserializarMigrante(const char* datos, size_t tamano, Migrante& migrante) {
+    size_t pos = 0;
+    auto leer = [&](void* destino, size_t n) {
+        if (pos + n > tamano) return false;
+        memcpy(destino, datos + pos, n);
+        pos += n;
+        return true;
+    };
+    auto leerLista = [&](vector<int>& lista) {
+        int32_t largo;
+        if (!leer(&largo, sizeof(largo)) || largo < 0) return false;
+        // un datagrama truncado o corrupto no puede pedir más ids de los que trae
+        if ((size_t)largo > (tamano - pos) / sizeof(int32_t)) return false;
+        lista.resize(largo);
+        for (int32_t i = 0; i < largo; ++i) {
+            int32_t id;
+            if (!leer(&id, sizeof(id))) return false;
+            lista[i] = id;
+        }
+        return true;
+    };
+
+    int32_t origen, numRutas;
+    if (!leer(&origen, sizeof(origen))) return false;
+    if (!leer(&migrante.profit, sizeof(migrante.profit))) return false;
+    if (!leer(&numRutas, sizeof(numRutas)) || numRutas < 0) return false;
+    // cada ruta ocupa al menos su largo
+    if ((size_t)numRutas > (tamano - pos) / sizeof(int32_t)) return false;
+
+    migrante.origen = origen;
+    migrante.rutas.resize(numRutas);
+    for (auto& ruta : migrante.rutas) {
+        if (!leerLista(ruta)) return false;
+    }
+    return leerLista(migrante.granjasNoVisitadas) && pos == tamano;
+}
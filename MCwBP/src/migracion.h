@@ -0,0 +1,52 @@
+#pragma once
+#include <vector>
+#include <string>
+
+using namespace std;
+
+// solución que viaja entre islas. el receptor la re-evalúa sobre su propia instancia.
+struct Migrante {
+    int origen;     // id de la isla que la publicó
+    double profit;  // profit según la isla de origen (solo informativo)
+    vector<vector<int>> rutas;
+    vector<int> granjasNoVisitadas;
+};
+
+// transporte de migrantes entre islas. publicar y recibir nunca deben bloquear el SA:
+// si un mensaje no se puede entregar de inmediato, se descarta.
+class CanalMigracion {
+public:
+    virtual ~CanalMigracion() = default;
+
+    // envía la solución a las demás islas
+    virtual void publicar(const Migrante& migrante) = 0;
+
+    // devuelve los migrantes llegados desde la última llamada
+    virtual vector<Migrante> recibir() = 0;
+};
+
+// canal sobre sockets Unix de datagramas: la isla i escucha en '<directorio>/isla<i>.sock'
+// y publica a los sockets de las demás islas del mismo directorio.
+class CanalUnixSocket : public CanalMigracion {
+public:
+    CanalUnixSocket(const string& directorio, int idIsla, int numIslas);
+    ~CanalUnixSocket() override;
+
+    CanalUnixSocket(const CanalUnixSocket&) = delete;
+    CanalUnixSocket& operator=(const CanalUnixSocket&) = delete;
+
+    void publicar(const Migrante& migrante) override;
+    vector<Migrante> recibir() override;
+
+    static string rutaSocket(const string& directorio, int idIsla);
+
+private:
+    string directorio;
+    int idIsla;
+    int numIslas;
+    int fd; // descriptor del socket propio
+};
+
+// serialización binaria usada por los canales (enteros de 32 bits y double nativos)
+string serializarMigrante(const Migrante& migrante);
+bool deserializarMigrante(const char* datos, size_t tamano, Migrante& migrante);
@@ -0,0 +1,61 @@
+#include "pool_hilos.h"
+#include <iostream>
+
+PoolHilos::PoolHilos(int n) {
+    if (n <= 0) n = max(1u, thread::hardware_concurrency());
+    for (int i = 0; i < n; ++i) hilos.emplace_back(&PoolHilos::bucle, this);
+}
+
+PoolHilos::~PoolHilos() {
+    {
+        lock_guard<mutex> lock(mtx);
+        terminar = true;
+    }
+    hayTarea.notify_all();
+    for (thread& hilo : hilos) hilo.join();
+}
+
+void PoolHilos::encolar(function<void()> tarea) {
+    {
+        lock_guard<mutex> lock(mtx);
+        cola.push(std::move(tarea));
+    }
+    hayTarea.notify_one();
+}
+
+void PoolHilos::esperarTodas() {
+    unique_lock<mutex> lock(mtx);
+    sinTareas.wait(lock, [&] { return cola.empty() && enEjecucion == 0; });
+}
+
+size_t PoolHilos::pendientes() {
+    lock_guard<mutex> lock(mtx);
+    return cola.size() + enEjecucion;
+}
+
+void PoolHilos::bucle() {
+    while (true) {
+        function<void()> tarea;
+        {
+            unique_lock<mutex> lock(mtx);
+            hayTarea.wait(lock, [&] { return !cola.empty() || terminar; });
+            if (cola.empty()) return; // terminar sin nada pendiente
+            tarea = std::move(cola.front());
+            cola.pop();
+            enEjecucion++;
+        }
+
+        // una tarea que lanza no debe tumbar el hilo
+        try {
+            tarea();
+        } catch (const exception& e) {
+            cerr << "Advertencia: tarea terminó con error: " << e.what() << endl;
+        }
+
+        {
+            lock_guard<mutex> lock(mtx);
+            enEjecucion--;
+            if (cola.empty() && enEjecucion == 0) sinTareas.notify_all();
+        }
+    }
+}
@@ -0,0 +1,39 @@
+#pragma once
+#include <vector>
+#include <queue>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+
+using namespace std;
+
+// conjunto fijo de hilos que ejecutan tareas de una cola compartida (FIFO)
+class PoolHilos {
+public:
+    // 0 hilos: uno por núcleo disponible
+    explicit PoolHilos(int numHilos = 0);
+    ~PoolHilos(); // termina las tareas pendientes y une los hilos
+
+    PoolHilos(const PoolHilos&) = delete;
+    PoolHilos& operator=(const PoolHilos&) = delete;
+
+    void encolar(function<void()> tarea);
+
+    // bloquea hasta que no quedan tareas en cola ni en ejecución
+    void esperarTodas();
+
+    int numHilos() const { return hilos.size(); }
+    size_t pendientes(); // en cola + en ejecución
+
+private:
+    void bucle();
+
+    vector<thread> hilos;
+    queue<function<void()>> cola;
+    mutex mtx;
+    condition_variable hayTarea;
+    condition_variable sinTareas;
+    int enEjecucion = 0;
+    bool terminar = false;
+};
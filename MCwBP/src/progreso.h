@@ -0,0 +1,70 @@
+#pragma once
+#include <atomic>
+
+using namespace std;
+
+// estado visible de una ejecución de SA en curso
+struct InstantaneaProgreso {
+    long long iteracion = 0;
+    long long maxIteraciones = 0;   // presupuesto vigente (puede acortarse por límite de tiempo)
+    double mejorProfit = 0.0;
+    bool mejorFactible = false;
+    double temperatura = 0.0;
+    bool terminada = false;
+};
+
+// publicación del progreso sin candados (seqlock): un único escritor (el bucle de SA) y
+// cualquier cantidad de lectores. el escritor nunca espera; el lector reintenta si leyó
+// mientras se escribía. los campos son atómicos con orden relajado para que la lectura
+// concurrente no sea una carrera de datos; el orden lo dan la secuencia y las barreras.
+class ProgresoSA {
+public:
+    void publicar(const InstantaneaProgreso& p) {
+        unsigned s = secuencia.load(memory_order_relaxed);
+        secuencia.store(s + 1, memory_order_relaxed); // impar: escritura en curso
+        atomic_thread_fence(memory_order_release);
+        iteracion.store(p.iteracion, memory_order_relaxed);
+        maxIteraciones.store(p.maxIteraciones, memory_order_relaxed);
+        mejorProfit.store(p.mejorProfit, memory_order_relaxed);
+        mejorFactible.store(p.mejorFactible, memory_order_relaxed);
+        temperatura.store(p.temperatura, memory_order_relaxed);
+        terminada.store(p.terminada, memory_order_relaxed);
+        secuencia.store(s + 2, memory_order_release);
+    }
+
+    InstantaneaProgreso leer() const {
+        InstantaneaProgreso p;
+        while (true) {
+            unsigned s1 = secuencia.load(memory_order_acquire);
+            if (s1 & 1) continue;
+            p.iteracion = iteracion.load(memory_order_relaxed);
+            p.maxIteraciones = maxIteraciones.load(memory_order_relaxed);
+            p.mejorProfit = mejorProfit.load(memory_order_relaxed);
+            p.mejorFactible = mejorFactible.load(memory_order_relaxed);
+            p.temperatura = temperatura.load(memory_order_relaxed);
+            p.terminada = terminada.load(memory_order_relaxed);
+            atomic_thread_fence(memory_order_acquire);
+            if (secuencia.load(memory_order_relaxed) == s1) return p;
+        }
+    }
+
+private:
+    atomic<unsigned> secuencia{0};
+    atomic<long long> iteracion{0};
+    atomic<long long> maxIteraciones{0};
+    atomic<double> mejorProfit{0.0};
+    atomic<bool> mejorFactible{false};
+    atomic<double> temperatura{0.0};
+    atomic<bool> terminada{false};
+};
+
+// cancelación cooperativa: el SA consulta el token en cada iteración (una lectura relajada)
+// y, si fue activado, termina devolviendo la mejor solución encontrada hasta ese momento
+class TokenCancelacion {
+public:
+    void cancelar() { activado.store(true, memory_order_relaxed); }
+    bool cancelado() const { return activado.load(memory_order_relaxed); }
+
+private:
+    atomic<bool> activado{false};
+};
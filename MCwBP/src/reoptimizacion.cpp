@@ -0,0 +1,295 @@
+#include "reoptimizacion.h"
+#include <fstream>
+#include <sstream>
+#include <set>
+#include <algorithm>
+#include <stdexcept>
+#include <iomanip>
+#include <limits>
+#include <cmath>
+
+// formato del plan estructurado:
+//   ruta <camion> <id> <id> ...
+//   novisitadas <id> ...
+//   granja <id> <x> <y>
+static const string CABECERA_PLAN = "# plan MCwBP";
+
+void guardarPlan(const string& path, const Solucion& sol, const Instancia& inst) {
+    ofstream out(path);
+    out << CABECERA_PLAN << "\n";
+    for (size_t k = 0; k < sol.rutas.size(); ++k) {
+        out << "ruta " << k;
+        for (int id : sol.rutas[k]) out << " " << id;
+        out << "\n";
+    }
+    out << "novisitadas";
+    for (int id : sol.granjasNoVisitadas) out << " " << id;
+    out << "\n";
+    // coordenadas con todos sus dígitos: identifican a la granja al día siguiente
+    out << setprecision(numeric_limits<double>::max_digits10);
+    for (const Nodo& granja : inst.granjas) {
+        out << "granja " << granja.id << " " << granja.x << " " << granja.y << "\n";
+    }
+}
+
+PlanPrevio leerPlan(const string& path) {
+    ifstream file(path);
+    if (!file.is_open()) throw runtime_error("No se pudo leer el plan " + path);
+
+    PlanPrevio plan;
+    string line;
+    getline(file, line);
+
+    if (line == CABECERA_PLAN) {
+        while (getline(file, line)) {
+            stringstream ss(line);
+            string tipo;
+            ss >> tipo;
+            if (tipo == "ruta") {
+                int camion, id;
+                ss >> camion;
+                vector<int> ruta;
+                while (ss >> id) ruta.push_back(id);
+                plan.rutas.push_back(ruta);
+                plan.camiones.push_back(camion);
+            } else if (tipo == "novisitadas") {
+                int id;
+                while (ss >> id) plan.granjasNoVisitadas.push_back(id);
+            } else if (tipo == "granja") {
+                int id;
+                double x, y;
+                if (ss >> id >> x >> y) plan.coordenadas[id] = {x, y};
+            }
+        }
+        return plan;
+    }
+
+    // archivo de results/: rutas "0-11-8-2-0 177 9800A" de la última sección de solución final
+    // (las rutas vacías no se imprimen, así que el camión de cada ruta se desconoce)
+    file.clear();
+    file.seekg(0, ios::beg);
+    while (getline(file, line)) {
+        if (line.find("Solución Final") != string::npos || line.find("Mejor Solución") != string::npos) {
+            plan.rutas.clear();
+            continue;
+        }
+        if (line.rfind("0-", 0) != 0) continue;
+
+        stringstream ss(line.substr(0, line.find(' ')));
+        string token;
+        vector<int> ruta;
+        while (getline(ss, token, '-')) {
+            int id = stoi(token);
+            if (id != 0) ruta.push_back(id);
+        }
+        plan.rutas.push_back(ruta);
+    }
+    plan.camiones.assign(plan.rutas.size(), -1);
+
+    if (plan.rutas.empty()) throw runtime_error("El archivo " + path + " no contiene rutas");
+    return plan;
+}
+
+// costo de sacar la granja en 'pos' de la ruta (distancia ahorrada)
+static double ahorroRemocion(const vector<int>& ruta, size_t pos, const Instancia& inst) {
+    int prev = (pos == 0) ? inst.planta.id : ruta[pos - 1];
+    int sig = (pos + 1 == ruta.size()) ? inst.planta.id : ruta[pos + 1];
+    return inst.getDistancia(prev, ruta[pos]) + inst.getDistancia(ruta[pos], sig) - inst.getDistancia(prev, sig);
+}
+
+// dos coordenadas son la misma si difieren menos que el redondeo con que se guardan en un plan
+static bool mismaCoordenada(double a, double b) {
+    return fabs(a - b) <= 1e-5 * max(1.0, max(fabs(a), fabs(b)));
+}
+
+// ID de hoy de cada granja del plan; cada ID de hoy se usa a lo más una vez.
+// sin coordenadas en el plan, el ID se conserva si existe hoy. con coordenadas, primero se
+// conservan los IDs cuyas coordenadas coinciden; el resto se busca por coordenadas entre las
+// granjas de hoy aún libres (la más cercana), así granjas que comparten coordenadas no se
+// confunden entre sí.
+static map<int, int> traducirIds(const PlanPrevio& plan, const Instancia& inst) {
+    map<int, int> traduccion;
+    set<int> idsHoy;
+    for (const Nodo& granja : inst.granjas) idsHoy.insert(granja.id);
+
+    if (plan.coordenadas.empty()) {
+        auto conservar = [&](int id) { if (idsHoy.count(id)) traduccion[id] = id; };
+        for (const auto& ruta : plan.rutas) for (int id : ruta) conservar(id);
+        for (int id : plan.granjasNoVisitadas) conservar(id);
+        return traduccion;
+    }
+
+    set<int> tomadas;
+    for (const auto& [idPrevio, c] : plan.coordenadas) {
+        if (!idsHoy.count(idPrevio)) continue;
+        const Nodo& granja = inst.getNodo(idPrevio);
+        if (mismaCoordenada(granja.x, c.first) && mismaCoordenada(granja.y, c.second)) {
+            traduccion[idPrevio] = idPrevio;
+            tomadas.insert(idPrevio);
+        }
+    }
+
+    multimap<double, int> idPorX; // granjas de hoy libres, por coordenada x
+    for (const Nodo& granja : inst.granjas) {
+        if (!tomadas.count(granja.id)) idPorX.insert({granja.x, granja.id});
+    }
+    for (const auto& [idPrevio, c] : plan.coordenadas) {
+        if (traduccion.count(idPrevio)) continue;
+        auto elegida = idPorX.end();
+        double mejor = numeric_limits<double>::max();
+        double margen = 2e-5 * max(1.0, fabs(c.first)); // algo más que la tolerancia, para no perder candidatas
+        for (auto it = idPorX.lower_bound(c.first - margen); it != idPorX.end() && it->first <= c.first + margen; ++it) {
+            const Nodo& granja = inst.getNodo(it->second);
+            if (!mismaCoordenada(granja.x, c.first) || !mismaCoordenada(granja.y, c.second)) continue;
+            double d = fabs(granja.x - c.first) + fabs(granja.y - c.second);
+            if (d < mejor) { mejor = d; elegida = it; }
+        }
+        if (elegida == idPorX.end()) continue;
+        traduccion[idPrevio] = elegida->second;
+        idPorX.erase(elegida);
+    }
+    return traduccion;
+}
+
+Solucion repararPlan(const PlanPrevio& plan, const Instancia& inst, const Algoritmo& algo,
+                     ReporteReoptimizacion& reporte, vector<vector<int>>& rutasTraducidas) {
+    reporte = ReporteReoptimizacion();
+
+    // 1. traducir IDs del plan a IDs de hoy
+    map<int, int> traduccion = traducirIds(plan, inst);
+    auto traducir = [&](int idPrevio) {
+        auto it = traduccion.find(idPrevio);
+        return it == traduccion.end() ? -1 : it->second;
+    };
+
+    // granjas que el plan conocía (en rutas o sin visitar); las demás son nuevas
+    set<int> conocidas;
+    for (int idPrevio : plan.granjasNoVisitadas) {
+        int id = traducir(idPrevio);
+        if (id >= 0) conocidas.insert(id);
+    }
+
+    set<int> asignadas;
+    vector<vector<int>> rutasHoy;
+    for (const auto& ruta : plan.rutas) {
+        vector<int> traducida;
+        for (int idPrevio : ruta) {
+            reporte.granjasPrevias++;
+            int id = traducir(idPrevio);
+            if (id < 0 || asignadas.count(id)) {
+                reporte.granjasEliminadas++;
+                continue;
+            }
+            traducida.push_back(id);
+            asignadas.insert(id);
+            conocidas.insert(id);
+            reporte.granjasConservadas++;
+        }
+        rutasHoy.push_back(traducida);
+    }
+
+    auto carga = [&](const vector<int>& ruta) {
+        int total = 0;
+        for (int id : ruta) total += inst.getNodo(id).cantidadLeche;
+        return total;
+    };
+
+    // 2. asignar rutas a camiones: se respeta el camión del plan si existe hoy; las demás
+    // se asignan de mayor carga a mayor capacidad entre los camiones libres
+    rutasTraducidas.assign(inst.numCamiones, {});
+    vector<bool> camionUsado(inst.numCamiones, false);
+    vector<int> sinCamion;
+    for (size_t r = 0; r < rutasHoy.size(); ++r) {
+        int k = plan.camiones[r];
+        if (k >= 0 && k < inst.numCamiones && !camionUsado[k]) {
+            rutasTraducidas[k] = rutasHoy[r];
+            camionUsado[k] = true;
+        } else {
+            sinCamion.push_back(r);
+        }
+    }
+
+    sort(sinCamion.begin(), sinCamion.end(), [&](int a, int b) { return carga(rutasHoy[a]) > carga(rutasHoy[b]); });
+    vector<int> camionesLibres;
+    for (int k = 0; k < inst.numCamiones; ++k) if (!camionUsado[k]) camionesLibres.push_back(k);
+    sort(camionesLibres.begin(), camionesLibres.end(), [&](int a, int b) {
+        return inst.capacidadesCamiones[a] > inst.capacidadesCamiones[b];
+    });
+
+    vector<int> pendientes; // IDs de hoy que hay que volver a insertar
+    for (size_t i = 0; i < sinCamion.size(); ++i) {
+        const vector<int>& ruta = rutasHoy[sinCamion[i]];
+        if (i < camionesLibres.size()) {
+            rutasTraducidas[camionesLibres[i]] = ruta;
+        } else if (!ruta.empty()) {
+            reporte.rutasSinCamion++;
+            pendientes.insert(pendientes.end(), ruta.begin(), ruta.end());
+        }
+    }
+
+    // 3. descargar camiones excedidos (volúmenes o capacidades cambiaron): se saca primero
+    // la granja cuya remoción ahorra más distancia
+    vector<vector<int>> rutas = rutasTraducidas;
+    for (int k = 0; k < inst.numCamiones; ++k) {
+        while (carga(rutas[k]) > inst.capacidadesCamiones[k]) {
+            size_t peor = 0;
+            for (size_t pos = 1; pos < rutas[k].size(); ++pos) {
+                if (ahorroRemocion(rutas[k], pos, inst) > ahorroRemocion(rutas[k], peor, inst)) peor = pos;
+            }
+            pendientes.push_back(rutas[k][peor]);
+            rutas[k].erase(rutas[k].begin() + peor);
+            reporte.removidasPorCapacidad++;
+        }
+    }
+
+    // 4. granjas nuevas (no estaban en las rutas del plan) + las sacadas, con inserción greedy
+    vector<Nodo> porInsertar;
+    for (int id : pendientes) porInsertar.push_back(inst.getNodo(id));
+    for (const Nodo& granja : inst.granjas) {
+        if (!asignadas.count(granja.id)) {
+            porInsertar.push_back(granja);
+            if (!conocidas.count(granja.id)) reporte.granjasNuevas++;
+        }
+    }
+
+    vector<int> noVisitadas;
+    algo.insertarGranjasGreedy(rutas, porInsertar, noVisitadas);
+    return Solucion(rutas, noVisitadas, inst);
+}
+
+void compararConPlanPrevio(const Solucion& final, const vector<vector<int>>& rutasTraducidas,
+                           const Instancia& inst, ReporteReoptimizacion& reporte) {
+    auto aristas = [&](const vector<vector<int>>& rutas) {
+        set<pair<int, int>> conjunto;
+        for (const auto& ruta : rutas) {
+            if (ruta.empty()) continue;
+            int previo = inst.planta.id;
+            for (int id : ruta) {
+                conjunto.insert({min(previo, id), max(previo, id)});
+                previo = id;
+            }
+            conjunto.insert({min(previo, inst.planta.id), max(previo, inst.planta.id)});
+        }
+        return conjunto;
+    };
+
+    set<pair<int, int>> previas = aristas(rutasTraducidas);
+    set<pair<int, int>> finales = aristas(final.rutas);
+    int conservadas = 0;
+    for (const auto& arista : previas) conservadas += finales.count(arista);
+    reporte.fraccionAristasConservadas = previas.empty() ? 0.0 : (double)conservadas / previas.size();
+
+    map<int, int> camionFinal;
+    for (size_t k = 0; k < final.rutas.size(); ++k) {
+        for (int id : final.rutas[k]) camionFinal[id] = k;
+    }
+    int total = 0, mismoCamion = 0;
+    for (size_t k = 0; k < rutasTraducidas.size(); ++k) {
+        for (int id : rutasTraducidas[k]) {
+            total++;
+            auto it = camionFinal.find(id);
+            if (it != camionFinal.end() && it->second == (int)k) mismoCamion++;
+        }
+    }
+    reporte.fraccionMismoCamion = total == 0 ? 0.0 : (double)mismoCamion / total;
+}
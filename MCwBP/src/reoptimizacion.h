@@ -0,0 +1,47 @@
+#pragma once
+#include <string>
+#include <vector>
+#include <map>
+#include "instancia.h"
+#include "solucion.h"
+#include "algoritmo.h"
+
+using namespace std;
+
+// plan de un día anterior: rutas con los IDs de granja de ese día
+struct PlanPrevio {
+    vector<vector<int>> rutas;
+    vector<int> camiones;   // camión de cada ruta (-1 si no se conoce, p.ej. al leer results/*.txt)
+    vector<int> granjasNoVisitadas;
+    map<int, pair<double, double>> coordenadas; // coordenadas por ID (vacío si no se conocen)
+};
+
+// lee un plan estructurado (.plan) o, si no lo es, las rutas de un archivo de results/
+PlanPrevio leerPlan(const string& path);
+
+// guarda la solución como plan estructurado para re-optimizar al día siguiente
+void guardarPlan(const string& path, const Solucion& sol, const Instancia& inst);
+
+// cuánto del plan anterior se pudo reutilizar
+struct ReporteReoptimizacion {
+    int granjasPrevias = 0;        // granjas en rutas del plan anterior
+    int granjasConservadas = 0;    // de ellas, las que siguen existiendo hoy
+    int granjasEliminadas = 0;     // las que ya no existen
+    int granjasNuevas = 0;         // granjas de hoy que el plan no conocía
+    int removidasPorCapacidad = 0; // sacadas de su camión por exceso de carga
+    int rutasSinCamion = 0;        // rutas cuyo camión ya no existe o no se pudo asignar
+
+    // comparación del plan final con el anterior (sobre granjas conservadas)
+    double fraccionAristasConservadas = 0.0;
+    double fraccionMismoCamion = 0.0;
+};
+
+// traduce el plan anterior a la instancia de hoy y lo repara: quita granjas eliminadas,
+// asigna rutas a camiones, descarga camiones excedidos e inserta granjas nuevas o sueltas
+// con la inserción greedy. 'reporte' recibe las cifras de la reparación.
+Solucion repararPlan(const PlanPrevio& plan, const Instancia& inst, const Algoritmo& algo,
+                     ReporteReoptimizacion& reporte, vector<vector<int>>& rutasTraducidas);
+
+// completa en 'reporte' la comparación entre el plan final y el plan anterior traducido
+void compararConPlanPrevio(const Solucion& final, const vector<vector<int>>& rutasTraducidas,
+                           const Instancia& inst, ReporteReoptimizacion& reporte);
@@ -0,0 +1,376 @@
+#include "servicio.h"
+#include <iostream>
+#include <iomanip>
+#include <sstream>
+#include <fstream>
+#include <algorithm>
+#include <thread>
+#include <stdexcept>
+#include <random>
+#include <csignal>
+#include <cstring>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+
+namespace {
+
+// FNV-1a de 64 bits sobre el contenido de la instancia
+uint64_t hashContenido(const string& s) {
+    uint64_t h = 1469598103934665603ULL;
+    for (unsigned char c : s) {
+        h ^= c;
+        h *= 1099511628211ULL;
+    }
+    return h;
+}
+
+// lectura por líneas sobre un descriptor (stdin o un socket)
+struct LectorLineas {
+    int fd;
+    string buffer;
+    size_t pos = 0;
+
+    bool leerLinea(string& linea) {
+        while (true) {
+            size_t fin = buffer.find('\n', pos);
+            if (fin != string::npos) {
+                linea = buffer.substr(pos, fin - pos);
+                if (!linea.empty() && linea.back() == '\r') linea.pop_back();
+                pos = fin + 1;
+                return true;
+            }
+            buffer.erase(0, pos);
+            pos = 0;
+
+            char bloque[65536];
+            ssize_t n = read(fd, bloque, sizeof(bloque));
+            if (n <= 0) {
+                if (buffer.empty()) return false;
+                linea.swap(buffer); // última línea sin salto
+                buffer.clear();
+                return true;
+            }
+            buffer.append(bloque, n);
+        }
+    }
+};
+
+double percentil(vector<double> valores, double p) {
+    if (valores.empty()) return 0.0;
+    size_t k = min(valores.size() - 1, (size_t)(p * valores.size()));
+    nth_element(valores.begin(), valores.begin() + k, valores.end());
+    return valores[k];
+}
+
+double milisegundos(chrono::steady_clock::duration d) {
+    return chrono::duration<double, milli>(d).count();
+}
+
+}
+
+// extremo de escritura de una conexión. las tareas del pool guardan una referencia,
+// así el descriptor sigue abierto hasta que se escribe la última respuesta.
+struct Servicio::Conexion {
+    int fd;
+    bool cerrar;
+    mutex mtx;
+
+    // solicitudes aceptadas y aún sin responder, para los comandos 'progreso' y 'cancelar'
+    struct Activa {
+        ProgresoSA progreso;
+        TokenCancelacion cancelacion;
+    };
+    mutex mtxActivas;
+    map<string, shared_ptr<Activa>> activas;
+
+    shared_ptr<Activa> buscarActiva(const string& id) {
+        lock_guard<mutex> lock(mtxActivas);
+        auto it = activas.find(id);
+        return it == activas.end() ? nullptr : it->second;
+    }
+
+    Conexion(int f, bool c) : fd(f), cerrar(c) {}
+    ~Conexion() { if (cerrar) close(fd); }
+
+    void responder(const string& datos) {
+        lock_guard<mutex> lock(mtx);
+        size_t escritos = 0;
+        while (escritos < datos.size()) {
+            ssize_t n = write(fd, datos.data() + escritos, datos.size() - escritos);
+            if (n <= 0) return; // el cliente se fue
+            escritos += n;
+        }
+    }
+};
+
+Servicio::Servicio(const ParametrosServicio& params)
+    : parametros(params), pool(params.numHilos),
+      baseSemillas(((uint64_t)random_device{}() << 32) ^ random_device{}()) {
+    if (parametros.ventanaMetricas == 0) throw invalid_argument("La ventana de metricas no puede ser vacia");
+    // un cliente que cierra antes de recibir su respuesta no debe terminar el proceso
+    signal(SIGPIPE, SIG_IGN);
+}
+
+shared_ptr<const Instancia> Servicio::obtenerInstancia(const string& contenido, bool& acierto, CotaSuperior& cota) {
+    uint64_t h = hashContenido(contenido);
+    {
+        lock_guard<mutex> lock(mtxCache);
+        auto it = cache.find(h);
+        if (it != cache.end() && it->second.contenido == contenido) {
+            acierto = true;
+            aciertosCache++;
+            cota = it->second.cota;
+            return it->second.instancia;
+        }
+    }
+
+    // se parsea fuera del candado: dos solicitudes simultáneas de una instancia nueva
+    // pueden parsearla ambas, pero ninguna espera a la otra
+    acierto = false;
+    fallosCache++;
+    istringstream entrada(contenido);
+    auto instancia = make_shared<const Instancia>(entrada);
+    cota = calcularCotaSuperior(*instancia);
+
+    lock_guard<mutex> lock(mtxCache);
+    if (!cache.count(h)) {
+        ordenCache.push_back(h);
+        while (ordenCache.size() > parametros.maxInstanciasCache) {
+            cache.erase(ordenCache.front());
+            ordenCache.pop_front();
+        }
+    }
+    cache[h] = {contenido, instancia, cota};
+    return instancia;
+}
+
+long Servicio::siguienteSemilla() {
+    // splitmix64 sobre base + contador: semillas distintas y bien repartidas para cada solicitud
+    uint64_t z = baseSemillas + 0x9e3779b97f4a7c15ULL * (contadorSemillas.fetch_add(1) + 1);
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+    z ^= z >> 31;
+    long semilla = (long)(z & 0x7fffffffffffffffULL);
+    return semilla != 0 ? semilla : 1; // 0 significa "usar la hora actual" en resolver()
+}
+
+void Servicio::registrarLatencia(double esperaMs, double totalMs, bool error) {
+    lock_guard<mutex> lock(mtxMetricas);
+    if (latenciasMs.size() < parametros.ventanaMetricas) {
+        latenciasMs.push_back(totalMs);
+        esperasMs.push_back(esperaMs);
+    } else {
+        latenciasMs[siguienteMuestra] = totalMs;
+        esperasMs[siguienteMuestra] = esperaMs;
+        siguienteMuestra = (siguienteMuestra + 1) % latenciasMs.size();
+    }
+    solicitudes++;
+    if (error) errores++;
+}
+
+string Servicio::resumenMetricas() {
+    // se copia la ventana bajo el candado y los percentiles se calculan fuera de él,
+    // para no frenar a los hilos que registran latencias
+    vector<double> latencias, esperas;
+    long long totalSolicitudes, totalErrores;
+    double segundos;
+    {
+        lock_guard<mutex> lock(mtxMetricas);
+        latencias = latenciasMs;
+        esperas = esperasMs;
+        totalSolicitudes = solicitudes;
+        totalErrores = errores;
+        segundos = hayPrimeraSolicitud
+            ? chrono::duration<double>(chrono::steady_clock::now() - primeraSolicitud).count() : 0.0;
+    }
+
+    ostringstream out;
+    out << "metricas solicitudes=" << totalSolicitudes << " errores=" << totalErrores
+        << " en_curso=" << pool.pendientes()
+        << " cache_aciertos=" << aciertosCache << " cache_fallos=" << fallosCache
+        << fixed << setprecision(2)
+        << " throughput=" << (segundos > 0 ? totalSolicitudes / segundos : 0.0)
+        << " p50_ms=" << percentil(latencias, 0.5) << " p99_ms=" << percentil(latencias, 0.99)
+        << " espera_p50_ms=" << percentil(esperas, 0.5) << " espera_p99_ms=" << percentil(esperas, 0.99)
+        << "\n";
+    return out.str();
+}
+
+void Servicio::atender(int fdEntrada, int fdSalida, bool cerrar) {
+    auto conexion = make_shared<Conexion>(fdSalida, cerrar);
+    LectorLineas lector{fdEntrada};
+    string linea;
+
+    while (lector.leerLinea(linea)) {
+        istringstream ss(linea);
+        string comando, id;
+        ss >> comando;
+        if (comando.empty()) continue;
+
+        if (comando == "metricas") {
+            conexion->responder(resumenMetricas());
+            continue;
+        }
+        if ((comando == "progreso" || comando == "cancelar") && (ss >> id)) {
+            shared_ptr<Conexion::Activa> activa = conexion->buscarActiva(id);
+            if (!activa) {
+                conexion->responder("error " + id + " no hay una solicitud activa con ese id\n");
+            } else if (comando == "cancelar") {
+                // la respuesta llega por el canal normal, con la mejor solución hasta ahora
+                activa->cancelacion.cancelar();
+            } else {
+                InstantaneaProgreso p = activa->progreso.leer();
+                ostringstream out;
+                out << "progreso " << id << " iteracion=" << p.iteracion << " de=" << p.maxIteraciones
+                    << " profit=" << fixed << setprecision(2) << p.mejorProfit << " factible=" << p.mejorFactible
+                    << " temperatura=" << p.temperatura << "\n";
+                conexion->responder(out.str());
+            }
+            continue;
+        }
+        if (comando != "resolver" || !(ss >> id)) {
+            conexion->responder("error - solicitud desconocida: " + linea + "\n");
+            continue;
+        }
+
+        auto recibida = chrono::steady_clock::now();
+        {
+            lock_guard<mutex> lock(mtxMetricas);
+            if (!hayPrimeraSolicitud) primeraSolicitud = recibida;
+            hayPrimeraSolicitud = true;
+        }
+
+        // opciones clave=valor
+        ParametrosSolver p;
+        p.sa = parametros.sa;
+        string rutaInstancia, error;
+        string opcion;
+        while (ss >> opcion) {
+            size_t igual = opcion.find('=');
+            string clave = opcion.substr(0, igual), valor = igual == string::npos ? "" : opcion.substr(igual + 1);
+            try {
+                if (clave == "instancia") rutaInstancia = valor;
+                else if (clave == "segundos") p.limiteSegundos = stod(valor);
+                else if (clave == "semilla") p.semilla = stol(valor);
+                else if (clave == "tasa") p.sa.tasaEnfriamiento = stod(valor);
+                else if (clave == "epsilon") p.epsilonBrecha = stod(valor);
+                else if (clave == "motor" && (valor == "sa" || valor == "genetico"))
+                    p.motor = valor == "sa" ? MotorBusqueda::SA : MotorBusqueda::Genetico;
+                else error = "opcion desconocida " + clave;
+            } catch (const exception&) {
+                error = "valor invalido en " + opcion;
+            }
+        }
+
+        // contenido de la instancia: en línea hasta "fin" o desde un archivo
+        string contenido;
+        if (rutaInstancia.empty()) {
+            bool terminada = false;
+            while (lector.leerLinea(linea)) {
+                if (linea == "fin") { terminada = true; break; }
+                contenido += linea;
+                contenido += '\n';
+            }
+            if (!terminada) error = "instancia sin 'fin'";
+        } else {
+            ifstream archivo(rutaInstancia);
+            if (!archivo) {
+                error = "no se pudo leer " + rutaInstancia;
+            } else {
+                stringstream buffer;
+                buffer << archivo.rdbuf();
+                contenido = buffer.str();
+            }
+        }
+
+        if (!error.empty()) {
+            conexion->responder("error " + id + " " + error + "\n");
+            registrarLatencia(0.0, milisegundos(chrono::steady_clock::now() - recibida), true);
+            continue;
+        }
+
+        if (p.semilla == 0) p.semilla = siguienteSemilla();
+
+        auto activa = make_shared<Conexion::Activa>();
+        p.progreso = &activa->progreso;
+        p.cancelacion = &activa->cancelacion;
+        {
+            lock_guard<mutex> lock(conexion->mtxActivas);
+            conexion->activas[id] = activa;
+        }
+
+        pool.encolar([this, conexion, activa, id, p, contenido = std::move(contenido), recibida] {
+            double esperaMs = milisegundos(chrono::steady_clock::now() - recibida);
+            ostringstream cuerpo;
+            string cabecera;
+            bool fallo = false;
+            try {
+                bool acierto;
+                CotaSuperior cota;
+                shared_ptr<const Instancia> inst = obtenerInstancia(contenido, acierto, cota);
+                ParametrosSolver pSolicitud = p;
+                pSolicitud.cota = &cota;
+                ResultadoSolver res = resolver(*inst, pSolicitud);
+                const Solucion& sol = res.solucion;
+
+                for (size_t k = 0; k < sol.rutas.size(); ++k) {
+                    cuerpo << "ruta " << k;
+                    for (int granja : sol.rutas[k]) cuerpo << " " << granja;
+                    cuerpo << "\n";
+                }
+                cuerpo << "novisitadas";
+                for (int granja : sol.granjasNoVisitadas) cuerpo << " " << granja;
+                cuerpo << "\nfin\n";
+
+                ostringstream c;
+                c << "ok " << id << " profit=" << fixed << setprecision(2) << sol.profit
+                  << " factible=" << sol.esFactible << " iteraciones=" << res.estadisticas.iteraciones
+                  << " espera_ms=" << esperaMs
+                  << " total_ms=" << milisegundos(chrono::steady_clock::now() - recibida)
+                  << " cache=" << (acierto ? "acierto" : "fallo")
+                  << " cancelada=" << res.estadisticas.cancelada
+                  << " cota=" << res.estadisticas.cota.profit << " brecha=" << setprecision(6) << res.estadisticas.brecha
+                  << " semilla=" << res.estadisticas.semilla << "\n";
+                cabecera = c.str();
+            } catch (const exception& e) {
+                cabecera = "error " + id + " " + e.what() + "\n";
+                cuerpo.str("");
+                fallo = true;
+            }
+            {
+                lock_guard<mutex> lock(conexion->mtxActivas);
+                auto it = conexion->activas.find(id);
+                if (it != conexion->activas.end() && it->second == activa) conexion->activas.erase(it);
+            }
+            registrarLatencia(esperaMs, milisegundos(chrono::steady_clock::now() - recibida), fallo);
+            conexion->responder(cabecera + cuerpo.str());
+        });
+    }
+}
+
+void Servicio::escuchar(const string& rutaSocket) {
+    int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0) throw runtime_error("No se pudo crear el socket del servicio");
+
+    sockaddr_un dir{};
+    dir.sun_family = AF_UNIX;
+    if (rutaSocket.size() >= sizeof(dir.sun_path)) throw runtime_error("Ruta de socket demasiado larga: " + rutaSocket);
+    strncpy(dir.sun_path, rutaSocket.c_str(), sizeof(dir.sun_path) - 1);
+
+    unlink(rutaSocket.c_str()); // restos de una ejecución anterior
+    if (bind(fd, (sockaddr*)&dir, sizeof(dir)) < 0 || listen(fd, 64) < 0) {
+        close(fd);
+        throw runtime_error("No se pudo escuchar en " + rutaSocket);
+    }
+
+    while (true) {
+        int cliente = accept(fd, nullptr, nullptr);
+        if (cliente < 0) continue;
+        thread([this, cliente] { atender(cliente, cliente, true); }).detach();
+    }
+}
+
+void Servicio::esperar() {
+    pool.esperarTodas();
+}
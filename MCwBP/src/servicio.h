@@ -0,0 +1,101 @@
+#pragma once
+#include <string>
+#include <vector>
+#include <map>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include "solver.h"
+#include "pool_hilos.h"
+
+using namespace std;
+
+// modo servicio: un proceso de larga duración que recibe solicitudes de resolución por stdin
+// o por un socket Unix, las ejecuta en un pool de hilos y responde en la misma conexión.
+//
+// protocolo (texto, una solicitud por línea de cabecera):
+//   resolver <id> [instancia=ruta] [segundos=S] [semilla=N] [tasa=T] [motor=sa|genetico] [epsilon=E]
+//     sin 'instancia=', las líneas siguientes hasta "fin" son el contenido de la instancia
+//   progreso <id>      estado en vivo de una solicitud en curso (de esta conexión)
+//   cancelar <id>      termina la solicitud; su respuesta trae la mejor solución hasta ese momento
+//   metricas
+// respuestas (pueden llegar en otro orden que las solicitudes; se identifican por <id>):
+//   ok <id> profit=P factible=0|1 iteraciones=I espera_ms=E total_ms=T cache=acierto|fallo cancelada=0|1
+//      cota=C brecha=B semilla=N (brecha=-1 si no es factible; sin 'semilla=' en la solicitud, el
+//      servicio elige una distinta para cada una y la informa para poder repetirla)
+//   ruta <camion> <id> ...
+//   novisitadas <id> ...
+//   fin
+//   error <id> <mensaje>
+//   progreso <id> iteracion=I de=M profit=P factible=0|1 temperatura=T
+//   metricas solicitudes=N errores=E ... p50_ms=X p99_ms=Y (percentiles de las últimas
+//     'ventanaMetricas' solicitudes; los contadores y el throughput cubren toda la ejecución)
+
+struct ParametrosServicio {
+    int numHilos = 0;                // 0: uno por núcleo
+    size_t maxInstanciasCache = 64;  // instancias parseadas que se conservan (FIFO)
+    size_t ventanaMetricas = 4096;   // latencias recientes sobre las que se calculan los percentiles
+    ParametrosSA sa;                 // parámetros base; cada solicitud puede cambiar la tasa
+};
+
+class Servicio {
+public:
+    explicit Servicio(const ParametrosServicio& params);
+
+    // atiende solicitudes leídas de 'fdEntrada' hasta EOF. las respuestas se escriben en
+    // 'fdSalida' a medida que terminan (si 'cerrar', el descriptor se cierra tras la última).
+    void atender(int fdEntrada, int fdSalida, bool cerrar = false);
+
+    // escucha en un socket Unix y atiende cada conexión en un hilo propio (no retorna)
+    void escuchar(const string& rutaSocket);
+
+    // espera a que terminen todas las solicitudes en curso
+    void esperar();
+
+    // línea "metricas ..." con contadores y throughput acumulados y latencias recientes
+    string resumenMetricas();
+
+private:
+    struct Conexion;
+    struct EntradaCache {
+        string contenido;
+        shared_ptr<const Instancia> instancia;
+        CotaSuperior cota;
+    };
+
+    // instancia parseada (con su matriz de distancias y su cota superior) para un contenido;
+    // 'acierto' indica si ya estaba en caché
+    shared_ptr<const Instancia> obtenerInstancia(const string& contenido, bool& acierto, CotaSuperior& cota);
+
+    void registrarLatencia(double esperaMs, double totalMs, bool error);
+
+    // semilla para una solicitud que no la fija: un contador mezclado con una base aleatoria del
+    // proceso, así dos solicitudes recibidas en el mismo segundo no repiten la trayectoria
+    long siguienteSemilla();
+
+    ParametrosServicio parametros;
+    PoolHilos pool;
+
+    mutex mtxCache;
+    map<uint64_t, EntradaCache> cache;  // por hash del contenido
+    deque<uint64_t> ordenCache;         // orden de inserción, para descartar la más antigua
+    atomic<long long> aciertosCache{0};
+    atomic<long long> fallosCache{0};
+
+    const uint64_t baseSemillas;
+    atomic<uint64_t> contadorSemillas{0};
+
+    // las latencias se guardan en un buffer circular de las últimas 'ventanaMetricas' solicitudes,
+    // para que la memoria y el costo de 'metricas' no crezcan con el tiempo que lleva el servicio
+    mutex mtxMetricas;
+    vector<double> latenciasMs;         // desde que se recibe la solicitud hasta que se responde
+    vector<double> esperasMs;           // tiempo en cola antes de empezar a resolver
+    size_t siguienteMuestra = 0;        // posición a sobrescribir cuando la ventana está llena
+    long long solicitudes = 0;
+    long long errores = 0;
+    bool hayPrimeraSolicitud = false;
+    chrono::steady_clock::time_point primeraSolicitud;
+};
@@ -71,10 +71,10 @@ void Solucion::evaluar(const Instancia& inst) {
 
 }
 
-void Solucion::imprimirFormatoSalida(long seed, const Instancia& inst) const {
-    cout << "Seed: " << seed << endl;
+void Solucion::imprimirFormatoSalida(long seed, const Instancia& inst, ostream& out) const {
+    out << "Seed: " << seed << endl;
     
-    cout << fixed << setprecision(0) << gananciaTotal << " "
+    out << fixed << setprecision(0) << gananciaTotal << " "
          << costoTransporte << " " << profit << endl;
 
     for (size_t k = 0; k < rutas.size(); ++k) {
@@ -101,6 +101,6 @@ void Solucion::imprimirFormatoSalida(long seed, const Instancia& inst) const {
         costoRuta += inst.getDistancia(nodoActual, 1); // usa la instancia pasada
         rutaStr += "-0";
 
-        cout << rutaStr << " " << (int)round(costoRuta) << " " << lecheTotal << calidadFinal << endl;
+        out << rutaStr << " " << (int)round(costoRuta) << " " << lecheTotal << calidadFinal << endl;
     }
 }
\ No newline at end of file
@@ -13,17 +13,20 @@ public:
     vector<int> granjasNoVisitadas;
 
     // metricas
-    double gananciaTotal;
-    double costoTransporte;
-    double profit;
-    bool esFactible;
+    double gananciaTotal = 0;
+    double costoTransporte = 0;
+    double profit = 0;
+    bool esFactible = false;
 
 public:
+    // solución vacía (sin rutas), útil como valor por defecto
+    Solucion() = default;
+
     // constructor para una solución 
     Solucion(const vector<vector<int>>& rutas, const vector<int>& noVisitadas, const Instancia& inst);
 
     // f.e.
     void evaluar(const Instancia& inst);
 
-    void imprimirFormatoSalida(long seed, const Instancia& inst) const;
+    void imprimirFormatoSalida(long seed, const Instancia& inst, ostream& out = cout) const;
 };
\ No newline at end of file
@@ -0,0 +1,140 @@
+#include "solucion_compacta.h"
+#include <cstring>
+#include <stdexcept>
+
+// --- pool ---
+
+PoolSoluciones::PoolSoluciones(int numRutas, int numGranjas, int porTramo)
+    : rutas(numRutas), tamano(numRutas + 2 + numGranjas), bloquesPorTramo(max(1, porTramo)) {
+    if (tamano > UINT16_MAX) throw invalid_argument("Instancia demasiado grande para la codificación compacta");
+}
+
+uint16_t* PoolSoluciones::obtener() {
+    if (libres.empty()) {
+        tramos.emplace_back(new uint16_t[tamano * bloquesPorTramo]);
+        uint16_t* tramo = tramos.back().get();
+        for (int i = bloquesPorTramo - 1; i >= 0; --i) libres.push_back(tramo + i * tamano);
+    }
+    uint16_t* bloque = libres.back();
+    libres.pop_back();
+    enUso++;
+    return bloque;
+}
+
+void PoolSoluciones::devolver(uint16_t* bloque) {
+    libres.push_back(bloque);
+    enUso--;
+}
+
+// --- solución compacta ---
+
+SolucionCompacta::SolucionCompacta(PoolSoluciones& p, const Solucion& sol) : pool(&p), bloque(p.obtener()) {
+    guardar(sol);
+}
+
+SolucionCompacta::SolucionCompacta(const SolucionCompacta& otra)
+    : gananciaTotal(otra.gananciaTotal), costoTransporte(otra.costoTransporte), profit(otra.profit),
+      esFactible(otra.esFactible), pool(otra.pool) {
+    if (otra.bloque) {
+        bloque = pool->obtener();
+        memcpy(bloque, otra.bloque, pool->bytesPorBloque());
+    }
+}
+
+SolucionCompacta::SolucionCompacta(SolucionCompacta&& otra) noexcept
+    : gananciaTotal(otra.gananciaTotal), costoTransporte(otra.costoTransporte), profit(otra.profit),
+      esFactible(otra.esFactible), pool(otra.pool), bloque(otra.bloque) {
+    otra.bloque = nullptr;
+}
+
+SolucionCompacta& SolucionCompacta::operator=(const SolucionCompacta& otra) {
+    if (this == &otra) return *this;
+    if (!otra.bloque) {
+        liberar();
+    } else {
+        // con un bloque del mismo pool basta copiar encima
+        if (bloque && pool != otra.pool) liberar();
+        pool = otra.pool;
+        if (!bloque) bloque = pool->obtener();
+        memcpy(bloque, otra.bloque, pool->bytesPorBloque());
+    }
+    gananciaTotal = otra.gananciaTotal;
+    costoTransporte = otra.costoTransporte;
+    profit = otra.profit;
+    esFactible = otra.esFactible;
+    return *this;
+}
+
+SolucionCompacta& SolucionCompacta::operator=(SolucionCompacta&& otra) noexcept {
+    if (this == &otra) return *this;
+    liberar();
+    pool = otra.pool;
+    bloque = otra.bloque;
+    otra.bloque = nullptr;
+    gananciaTotal = otra.gananciaTotal;
+    costoTransporte = otra.costoTransporte;
+    profit = otra.profit;
+    esFactible = otra.esFactible;
+    return *this;
+}
+
+SolucionCompacta::~SolucionCompacta() {
+    liberar();
+}
+
+void SolucionCompacta::liberar() {
+    if (bloque) pool->devolver(bloque);
+    bloque = nullptr;
+}
+
+int SolucionCompacta::numRutas() const {
+    return pool->numRutas();
+}
+
+void SolucionCompacta::guardar(const Solucion& sol) {
+    int m = pool->numRutas();
+    if ((int)sol.rutas.size() != m) throw invalid_argument("La solución no tiene una ruta por camión");
+
+    size_t total = sol.granjasNoVisitadas.size();
+    for (const auto& ruta : sol.rutas) total += ruta.size();
+    if (total > pool->capacidadIds()) throw invalid_argument("La solución tiene más granjas que la instancia");
+
+    uint16_t pos = m + 2;
+    uint16_t* escribir = bloque + pos;
+    auto copiar = [&](const vector<int>& ids) {
+        for (int id : ids) {
+            if (id < 0 || id > UINT16_MAX) throw invalid_argument("Id de granja fuera de rango: " + to_string(id));
+            *escribir++ = id;
+        }
+        pos += ids.size();
+    };
+
+    for (int k = 0; k < m; ++k) {
+        bloque[k] = pos;
+        copiar(sol.rutas[k]);
+    }
+    bloque[m] = pos;
+    copiar(sol.granjasNoVisitadas);
+    bloque[m + 1] = pos;
+
+    gananciaTotal = sol.gananciaTotal;
+    costoTransporte = sol.costoTransporte;
+    profit = sol.profit;
+    esFactible = sol.esFactible;
+}
+
+Solucion SolucionCompacta::expandir() const {
+    Solucion sol;
+    if (!bloque) return sol;
+
+    int m = numRutas();
+    sol.rutas.resize(m);
+    for (int k = 0; k < m; ++k) sol.rutas[k].assign(inicioRuta(k), finRuta(k));
+    sol.granjasNoVisitadas.assign(inicioNoVisitadas(), finNoVisitadas());
+
+    sol.gananciaTotal = gananciaTotal;
+    sol.costoTransporte = costoTransporte;
+    sol.profit = profit;
+    sol.esFactible = esFactible;
+    return sol;
+}
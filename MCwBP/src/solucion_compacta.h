@@ -0,0 +1,84 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+#include <memory>
+#include "solucion.h"
+
+using namespace std;
+
+class PoolSoluciones;
+
+// codificación compacta de una solución para guardarla (mejor solución, pool élite).
+// todo vive en un solo bloque de enteros de 16 bits: una tabla de desplazamientos y luego
+// el "giant tour" (las rutas una tras otra) con las granjas no visitadas como cola:
+//
+//   [ini ruta 0] ... [ini ruta m-1] [ini no visitadas] [fin] | ids de las rutas ... | no visitadas ...
+//
+// los bloques son de tamaño fijo por instancia y salen de un PoolSoluciones, así copiar una
+// solución compacta sobre otra es un memcpy y guardar una Solucion no reserva memoria.
+class SolucionCompacta {
+public:
+    // métricas de la solución codificada (se copian tal cual, no se re-evalúa)
+    double gananciaTotal = 0;
+    double costoTransporte = 0;
+    double profit = 0;
+    bool esFactible = false;
+
+    SolucionCompacta() = default; // sin bloque
+    SolucionCompacta(PoolSoluciones& pool, const Solucion& sol);
+
+    SolucionCompacta(const SolucionCompacta& otra);
+    SolucionCompacta(SolucionCompacta&& otra) noexcept;
+    SolucionCompacta& operator=(const SolucionCompacta& otra);
+    SolucionCompacta& operator=(SolucionCompacta&& otra) noexcept;
+    ~SolucionCompacta();
+
+    // re-codifica 'sol' en el bloque que ya tiene. lanza invalid_argument si no cabe
+    // (otra cantidad de camiones, más granjas que la instancia o ids fuera de 16 bits)
+    void guardar(const Solucion& sol);
+
+    // reconstruye la representación por vectores (con las mismas métricas)
+    Solucion expandir() const;
+
+    bool vacia() const { return bloque == nullptr; }
+    int numRutas() const;
+
+    const uint16_t* inicioRuta(int k) const { return bloque + bloque[k]; }
+    const uint16_t* finRuta(int k) const { return bloque + bloque[k + 1]; }
+    const uint16_t* inicioNoVisitadas() const { return bloque + bloque[numRutas()]; }
+    const uint16_t* finNoVisitadas() const { return bloque + bloque[numRutas() + 1]; }
+
+private:
+    void liberar();
+
+    PoolSoluciones* pool = nullptr;
+    uint16_t* bloque = nullptr;
+};
+
+// arena de bloques de tamaño fijo para las soluciones compactas de una instancia. reserva
+// tramos de varios bloques a la vez y recicla los bloques liberados. no es thread-safe:
+// cada Algoritmo tiene el suyo.
+class PoolSoluciones {
+public:
+    PoolSoluciones(int numRutas, int numGranjas, int bloquesPorTramo = 32);
+
+    PoolSoluciones(const PoolSoluciones&) = delete;
+    PoolSoluciones& operator=(const PoolSoluciones&) = delete;
+
+    uint16_t* obtener();
+    void devolver(uint16_t* bloque);
+
+    int numRutas() const { return rutas; }
+    size_t capacidadIds() const { return tamano - (rutas + 2); }
+    size_t bytesPorBloque() const { return tamano * sizeof(uint16_t); }
+    size_t bloquesEnUso() const { return enUso; }
+    size_t bytesReservados() const { return tramos.size() * bloquesPorTramo * bytesPorBloque(); }
+
+private:
+    int rutas;
+    size_t tamano;          // enteros de 16 bits por bloque (tabla + ids)
+    int bloquesPorTramo;
+    vector<unique_ptr<uint16_t[]>> tramos;
+    vector<uint16_t*> libres;
+    size_t enUso = 0;
+};
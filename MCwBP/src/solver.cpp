@@ -0,0 +1,116 @@
+#include "solver.h"
+#include <chrono>
+#include <ctime>
+#include <stdexcept>
+
+const char* nombreMotor(MotorBusqueda motor) {
+    switch (motor) {
+        case MotorBusqueda::Genetico: return "genetico";
+        default: return "sa";
+    }
+}
+
+// la brecha solo tiene sentido para soluciones factibles (la cota no acota a las demás)
+static void registrarBrecha(ResultadoSolver& res, const CotaSuperior& cota) {
+    res.estadisticas.cota = cota;
+    res.estadisticas.brecha = res.solucion.esFactible ? brechaOptimalidad(res.solucion.profit, cota) : -1.0;
+}
+
+// motor genético: la solución greedy solo se informa (el genético la incluye en su población)
+static ResultadoSolver resolverGenetico(const Instancia& inst, const ParametrosSolver& params, long semilla,
+                                        const CotaSuperior& cota) {
+    const ParametrosGenetico& pg = params.genetico;
+    if (pg.tamanoPoblacion < 2 || pg.hijosPorGeneracion < 1 || pg.iteracionesEducacion < 1) {
+        throw invalid_argument("Parámetros del genético inválidos");
+    }
+    if (!params.checkpoint.ruta.empty()) {
+        throw invalid_argument("Los checkpoints solo están disponibles con el motor SA");
+    }
+
+    auto inicio = chrono::steady_clock::now();
+    ResultadoSolver res;
+    EstadisticasSolver& est = res.estadisticas;
+
+    Algoritmo greedy(inst, semilla);
+    Solucion solInicial = greedy.generarSolucionInicialGreedy();
+    est.profitInicial = solInicial.profit;
+    est.factibleInicial = solInicial.esFactible;
+
+    AlgoritmoGenetico ag(inst, semilla, pg);
+    ag.parametrosPenalizacion = params.penalizacion;
+    ag.limiteSegundos = params.limiteSegundos;
+    ag.progreso = params.progreso;
+    ag.cancelacion = params.cancelacion;
+    ag.cotaSuperior = &cota;
+    ag.epsilonBrecha = params.epsilonBrecha;
+
+    res.solucion = ag.ejecutar();
+    res.historial = std::move(ag.historialConvergencia);
+
+    est.segundos = chrono::duration<double>(chrono::steady_clock::now() - inicio).count();
+    est.semilla = semilla;
+    est.iteraciones = ag.iteracionesEducacion;
+    est.generaciones = ag.generaciones;
+    est.cancelada = ag.cancelada;
+    est.tiempoPrimerFactible = ag.tiempoPrimerFactible;
+    est.iteracionPrimerFactible = ag.iteracionPrimerFactible;
+    est.terminadaPorBrecha = ag.terminadaPorBrecha;
+    registrarBrecha(res, cota);
+    return res;
+}
+
+ResultadoSolver resolver(const Instancia& inst, const ParametrosSolver& params) {
+    const ParametrosSA& sa = params.sa;
+    if (!(sa.tempInicial > sa.tempFinal) || sa.tempFinal <= 0.0) {
+        throw invalid_argument("Se requiere tempInicial > tempFinal > 0");
+    }
+    if (!(sa.tasaEnfriamiento > 0.0 && sa.tasaEnfriamiento < 1.0)) {
+        throw invalid_argument("La tasa de enfriamiento debe estar en (0, 1)");
+    }
+    if (params.limiteSegundos < 0.0) {
+        throw invalid_argument("El límite de tiempo no puede ser negativo");
+    }
+
+    long semilla = params.semilla != 0 ? params.semilla : (long)time(nullptr);
+    CotaSuperior cota = params.cota ? *params.cota : calcularCotaSuperior(inst);
+    if (params.motor == MotorBusqueda::Genetico) return resolverGenetico(inst, params, semilla, cota);
+
+    auto inicio = chrono::steady_clock::now();
+
+    Algoritmo algo(inst, semilla);
+    algo.parametrosPenalizacion = params.penalizacion;
+    algo.parametrosEstancamiento = params.estancamiento;
+    algo.parametrosCheckpoint = params.checkpoint;
+    algo.limiteSegundos = params.limiteSegundos;
+    algo.mostrarLog = params.mostrarLog;
+    algo.progreso = params.progreso;
+    algo.cancelacion = params.cancelacion;
+    algo.cotaSuperior = &cota;
+    algo.epsilonBrecha = params.epsilonBrecha;
+
+    ResultadoSolver res;
+    EstadisticasSolver& est = res.estadisticas;
+
+    Solucion solInicial = algo.generarSolucionInicialGreedy();
+    est.profitInicial = solInicial.profit;
+    est.factibleInicial = solInicial.esFactible;
+
+    res.solucion = algo.ejecutarSimulatedAnnealing(sa);
+    res.historial = std::move(algo.historialConvergencia);
+
+    est.segundos = chrono::duration<double>(chrono::steady_clock::now() - inicio).count();
+    est.semilla = algo.getSeed();
+    est.iteraciones = algo.iteracionesRealizadas;
+    est.cancelada = algo.cancelada;
+    est.tiempoPrimerFactible = algo.tiempoPrimerFactible;
+    est.iteracionPrimerFactible = algo.iteracionPrimerFactible;
+    est.recalentamientos = algo.numRecalentamientos;
+    est.reinicios = algo.numReinicios;
+    est.reparacion = algo.estadisticasReparacion;
+    est.temperaturaCalibrada = algo.temperaturaCalibrada;
+    est.calibracion = algo.calibracion;
+    est.tasaCalibrada = algo.tasaCalibrada;
+    est.terminadaPorBrecha = algo.terminadaPorBrecha;
+    registrarBrecha(res, cota);
+    return res;
+}
@@ -0,0 +1,81 @@
+#pragma once
+#include <vector>
+#include "instancia.h"
+#include "solucion.h"
+#include "algoritmo.h"
+#include "progreso.h"
+#include "genetico.h"
+#include "cota.h"
+
+using namespace std;
+
+// API en memoria de la biblioteca (lib/libmcwb.a): construir una Instancia (desde archivo o
+// desde arreglos) y llamar a resolver(). los errores se reportan con excepciones.
+
+// motor de búsqueda a partir de la solución greedy
+enum class MotorBusqueda {
+    SA,         // simulated annealing de una trayectoria (por defecto)
+    Genetico    // búsqueda genética híbrida con educación por SA corto
+};
+
+const char* nombreMotor(MotorBusqueda motor);
+
+// todo lo configurable de una ejecución Greedy + SA (o Greedy + genético)
+struct ParametrosSolver {
+    MotorBusqueda motor = MotorBusqueda::SA;
+    ParametrosSA sa;
+    ParametrosGenetico genetico;       // solo con MotorBusqueda::Genetico
+    ParametrosPenalizacion penalizacion;
+    ParametrosEstancamiento estancamiento;
+    ParametrosCheckpoint checkpoint;   // desactivado por defecto (ruta vacía)
+    double limiteSegundos = 0.0;       // presupuesto de tiempo del motor (0: solo el de iteraciones/generaciones)
+    long semilla = 0;                  // 0: se usa la hora actual
+    bool mostrarLog = false;           // la biblioteca no escribe en cout salvo que se pida
+
+    // terminación temprana: el motor se detiene cuando su mejor solución es factible y está a
+    // lo más 'epsilonBrecha' (relativo) de la cota superior. con 0 solo se detiene si prueba el
+    // óptimo; con un valor negativo nunca. si 'cota' es nula, resolver() la calcula.
+    double epsilonBrecha = 0.0;
+    const CotaSuperior* cota = nullptr;
+
+    // opcionales, deben vivir mientras dure resolver(): el progreso se puede leer desde otro
+    // hilo y activar el token termina el SA devolviendo la mejor solución hasta ese momento
+    ProgresoSA* progreso = nullptr;
+    const TokenCancelacion* cancelacion = nullptr;
+};
+
+// cifras de la ejecución
+struct EstadisticasSolver {
+    long semilla = 0;                  // semilla efectivamente usada (al reanudar, la del checkpoint)
+    double segundos = 0.0;             // tiempo de pared de greedy + SA
+    long long iteraciones = 0;         // del SA; con el genético, las de educación sumadas
+    int generaciones = 0;              // solo el genético
+    bool cancelada = false;            // terminó por el token de cancelación
+
+    double profitInicial = 0.0;        // solución greedy
+    bool factibleInicial = false;
+
+    double tiempoPrimerFactible = -1.0;
+    long long iteracionPrimerFactible = -1;
+    int recalentamientos = 0;
+    int reinicios = 0;
+    EstadisticasReparacion reparacion; // solo el SA
+
+    CotaSuperior cota;                 // cota superior de la instancia
+    double brecha = -1.0;              // de la solución final respecto de la cota (-1 si no es factible)
+    bool terminadaPorBrecha = false;
+
+    bool temperaturaCalibrada = false;
+    CalibracionTemperatura calibracion{};
+    double tasaCalibrada = 0.0;
+};
+
+struct ResultadoSolver {
+    Solucion solucion;
+    EstadisticasSolver estadisticas;
+    vector<RegistroConvergencia> historial;
+};
+
+// resuelve la instancia con el motor elegido. lanza runtime_error si un checkpoint configurado
+// está corrupto y invalid_argument si los parámetros no tienen sentido.
+ResultadoSolver resolver(const Instancia& inst, const ParametrosSolver& params = ParametrosSolver());